@@ -0,0 +1,224 @@
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <new>
+#include <random>
+#include <vector>
+
+#include <constants.h>
+#include <lane_query.h>
+#include <stacking.h>
+#include <threadmill.h>
+#include <work_stealing_pool.h>
+
+/**
+ * @file bench.cpp
+ * @brief Benchmarks dos caminhos críticos das esteiras, sem janela e sem SFML.
+ *
+ * Para cada combinação de número de esteiras (1 a 64) e pacotes por esteira (10^2 a 10^6) mede:
+ * - add: addPackage() seguido da aplicação do comando por uma esteira preenchida; para manter a
+ *   população, cada lote de pacotes adicionados é seguido da remoção dos mais antigos, que
+ *   entra na medida;
+ * - tick: um passo de SIMULATION_STEP de todas as esteiras, submetidas ao WorkStealingPool, e a
+ *   reposição dos pacotes que expiraram, de modo que a população das esteiras fica constante;
+ * - snapshot: leitura do snapshot e cálculo das posições (o que a thread principal faz por quadro);
+ * - query: busca dos pacotes ao alcance do jogador (o critério de collectPackage), sem remover;
+ * - collect: Threadmill::tryCollect, que encontra e remove o pacote, e o consumo do LaneEvent;
+ *   cada pacote coletado é reposto, mantendo a população da esteira;
+ * - stacking: detecção de pilhas com forEachStack, como no Renderer, sobre uma esteira recém
+ *   preenchida.
+ *
+ * add, query, collect e stacking dependem de uma única esteira e só são medidos com 1 esteira.
+ * Cada linha informa ns por operação, operações por segundo e alocações por operação, contadas
+ * pela substituição global de operator new. Combinações acima de MAX_TOTAL_PACKAGES pacotes no
+ * total são puladas para caber na memória de uma máquina comum.
+ *
+ * Uso: `make bench`.
+ */
+
+namespace {
+
+std::atomic<uint64_t> allocationCount{0};
+volatile std::size_t benchSink = 0;
+
+constexpr std::size_t MAX_TOTAL_PACKAGES = 4'000'000;
+constexpr int FILL_GROUPS = 64;
+// Pacotes adicionados por chamada no caso add; não passa de Threadmill::COMMAND_CAPACITY.
+constexpr int ADD_BATCH = 256;
+constexpr double TARGET_SECONDS = 0.2;
+
+using BenchClock = std::chrono::steady_clock;
+
+struct Result {
+    double nsPerOp;
+    double allocsPerOp;
+};
+
+/**
+ * @brief Executa `fn` em lotes até somar TARGET_SECONDS e retorna o custo médio por operação.
+ *
+ * @param opsPerCall Quantas operações cada chamada de `fn` representa.
+ */
+template <typename Fn> Result measure(uint64_t opsPerCall, Fn &&fn) {
+    fn();
+
+    uint64_t calls = 0;
+    uint64_t allocationsBefore = allocationCount.load(std::memory_order_relaxed);
+    auto start = BenchClock::now();
+    std::chrono::duration<double> elapsed{0.0};
+    do {
+        fn();
+        ++calls;
+        elapsed = BenchClock::now() - start;
+    } while (elapsed.count() < TARGET_SECONDS);
+    uint64_t allocations = allocationCount.load(std::memory_order_relaxed) - allocationsBefore;
+
+    double ops = static_cast<double>(calls * opsPerCall);
+    return {elapsed.count() * 1e9 / ops, static_cast<double>(allocations) / ops};
+}
+
+void report(const char *name, int lanes, std::size_t packagesPerLane, Result result) {
+    std::printf("%-10s %6d %10zu %14.1f %16.0f %12.3f\n", name, lanes, packagesPerLane,
+                result.nsPerOp, 1e9 / result.nsPerOp, result.allocsPerOp);
+}
+
+/**
+ * @brief Preenche a esteira com `count` pacotes espalhados pela largura da tela.
+ *
+ * Os pacotes entram em FILL_GROUPS lotes separados por passos de simulação, formando grupos
+ * empilhados distribuídos entre o início e 90% da esteira.
+ */
+int fillLane(Threadmill &lane, std::size_t count, int firstId) {
+    float dt = 0.9f * WIDTH / (PACKAGE_SPEED_BASE * FILL_GROUPS);
+    std::size_t perGroup = count / FILL_GROUPS;
+    for (int group = 0; group < FILL_GROUPS; ++group) {
+        int groupCount = static_cast<int>(group + 1 == FILL_GROUPS
+                                              ? count - perGroup * (FILL_GROUPS - 1)
+                                              : perGroup);
+        lane.addPackages(firstId, groupCount);
+        firstId += groupCount;
+        lane.step(dt);
+    }
+    return firstId;
+}
+
+void runCase(WorkStealingPool &pool, int laneCount, std::size_t packagesPerLane) {
+    std::vector<std::unique_ptr<Threadmill>> lanes;
+    int nextId = 1;
+    for (int i = 0; i < laneCount; ++i) {
+        lanes.push_back(std::make_unique<Threadmill>(0, PACKAGE_SPEED_BASE));
+        lanes.back()->activate();
+        nextId = fillLane(*lanes.back(), packagesPerLane, nextId);
+    }
+
+    report("tick", laneCount, packagesPerLane, measure(1, [&] {
+               for (auto &lane : lanes) {
+                   Threadmill *threadmill = lane.get();
+                   pool.submit([threadmill] { threadmill->step(SIMULATION_STEP); });
+               }
+               pool.wait();
+               for (auto &lane : lanes) {
+                   int expired = 0;
+                   lane->drainEvents([&expired](const LaneEvent &event) {
+                       if (event.type == LaneEvent::EXPIRED)
+                           expired += event.count;
+                   });
+                   lane->addPackages(nextId, expired);
+                   nextId += expired;
+               }
+           }));
+
+    std::vector<float> xs;
+    report("snapshot", laneCount, packagesPerLane, measure(1, [&] {
+               for (auto &lane : lanes) {
+                   lane->acquireSnapshot().positions(xs);
+               }
+           }));
+
+    if (laneCount != 1)
+        return;
+
+    Threadmill &first = *lanes.front();
+    {
+        Threadmill scratch(0, PACKAGE_SPEED_BASE);
+        scratch.activate();
+        int oldestId = 1;
+        int id = fillLane(scratch, packagesPerLane, oldestId);
+        report("add", 1, packagesPerLane, measure(ADD_BATCH, [&] {
+                   for (int i = 0; i < ADD_BATCH; ++i) {
+                       scratch.addPackage(id++);
+                   }
+                   scratch.applyCommands();
+                   for (int i = 0; i < ADD_BATCH; ++i) {
+                       scratch.removePackage(oldestId++);
+                   }
+                   scratch.applyCommands();
+                   scratch.drainEvents([](const LaneEvent &) {});
+               }));
+    }
+
+    std::mt19937 rng(42);
+    std::uniform_real_distribution<float> playerX(0.0f, WIDTH - PLAYER_SIZE);
+    const LaneSnapshot &snapshot = first.acquireSnapshot();
+    report("query", 1, packagesPerLane, measure(1, [&] {
+               float left = playerX(rng);
+               auto range = findPackagesByCenter(snapshot.size(), left, left + PLAYER_SIZE,
+                                                 [&](std::size_t i) { return snapshot.xAt(i); });
+               benchSink = benchSink + (range.second - range.first);
+           }));
+
+    report("collect", 1, packagesPerLane, measure(1, [&] {
+               float left = playerX(rng);
+               if (first.tryCollect(left, left + PLAYER_SIZE)) {
+                   first.addPackage(nextId++);
+               }
+               first.drainEvents([](const LaneEvent &) {});
+           }));
+
+    {
+        Threadmill filled(0, PACKAGE_SPEED_BASE);
+        filled.activate();
+        fillLane(filled, packagesPerLane, 1);
+        filled.acquireSnapshot().positions(xs);
+    }
+    report("stacking", 1, packagesPerLane, measure(1, [&] {
+               forEachStack(xs.data(), xs.size(),
+                            [](float, int count) { benchSink = benchSink + count; });
+           }));
+}
+
+} // namespace
+
+void *operator new(std::size_t size) {
+    allocationCount.fetch_add(1, std::memory_order_relaxed);
+    if (void *pointer = std::malloc(size ? size : 1))
+        return pointer;
+    throw std::bad_alloc();
+}
+
+void operator delete(void *pointer) noexcept {
+    std::free(pointer);
+}
+
+void operator delete(void *pointer, std::size_t) noexcept {
+    std::free(pointer);
+}
+
+int main() {
+    WorkStealingPool pool;
+    std::printf("%-10s %6s %10s %14s %16s %12s\n", "benchmark", "lanes", "pkgs/lane", "ns/op",
+                "ops/s", "allocs/op");
+
+    const int laneCounts[] = {1, 4, 16, 64};
+    const std::size_t packageCounts[] = {100, 1'000, 10'000, 100'000, 1'000'000};
+    for (int lanes : laneCounts) {
+        for (std::size_t packages : packageCounts) {
+            if (lanes * packages > MAX_TOTAL_PACKAGES)
+                continue;
+            runCase(pool, lanes, packages);
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,42 @@
+#ifndef AUTOPLAYER_H
+#define AUTOPLAYER_H
+
+class SimulationWorld;
+
+/**
+ * @struct AutoplayerAction
+ * @brief Ações escolhidas pelo Autoplayer para um passo.
+ *
+ * `laneDirection` é a troca de faixa (-1, 0 ou 1), `collect` indica se uma coleta deve ser
+ * tentada e `direction` é a direção horizontal do passo (-1, 0 ou 1). Quem aplica as ações é o
+ * chamador, na mesma ordem que Game e replayRecording: troca de faixa, coleta, movimento.
+ */
+struct AutoplayerAction {
+    int laneDirection = 0;
+    bool collect = false;
+    int direction = 0;
+};
+
+/**
+ * @class Autoplayer
+ * @brief Jogador automático que decide, a cada passo, a partir do estado das esteiras.
+ *
+ * Serve para manter o jogo em sua dificuldade máxima (intervalo de geração em
+ * PACKAGE_SPAWN_INTERVAL_MIN e velocidades crescentes) por tempo indeterminado, o que um jogador
+ * humano raramente alcança, para medir os caminhos críticos sob essa carga. Pode jogar na janela
+ * (`./exec --autoplay`) ou sem janela, em cada partida de um SessionHost.
+ *
+ * A decisão lê apenas os snapshots das esteiras e o Player, como o FrameState: tenta coletar
+ * sempre que o centro de um pacote da esteira atual está ao alcance; persegue o pacote mais à
+ * frente que ainda não passou pelo jogador; e, quando a esteira atual não tem mais nenhum pacote
+ * alcançável, segue em direção à esteira com mais pacotes.
+ *
+ * @note Lê os snapshots das esteiras e, portanto, deve ser chamado pela mesma thread que os lê
+ *       para desenhar.
+ */
+class Autoplayer {
+public:
+    AutoplayerAction decide(SimulationWorld &world) const;
+};
+
+#endif // AUTOPLAYER_H
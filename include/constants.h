@@ -1,8 +1,6 @@
 #ifndef CONSTANTS_H
 #define CONSTANTS_H
 
-#include <SFML/Graphics.hpp>
-
 #define WIDTH 800
 #define HEIGHT 600
 #define INVALID -1
@@ -14,8 +12,9 @@
 #define SCORE_THRESHOLD 5                
 #define THREADMILL_HEIGHT 80
 #define THREADMILL_Y_POS_CENTER 250
-#define THREADMILL_Y_POS_TOP (THREADMILL_Y_POS_CENTER - THREADMILL_HEIGHT - 100)
-#define THREADMILL_Y_POS_BOTTOM (THREADMILL_Y_POS_CENTER + THREADMILL_HEIGHT + 100)
+#define THREADMILL_LANE_SPACING (THREADMILL_HEIGHT + 100)
+#define THREADMILL_Y_POS_TOP (THREADMILL_Y_POS_CENTER - THREADMILL_LANE_SPACING)
+#define THREADMILL_Y_POS_BOTTOM (THREADMILL_Y_POS_CENTER + THREADMILL_LANE_SPACING)
 #define THREADMILL_COLOR sf::Color::Red
 #define SCORE_TEXT_SIZE 24
 #define SCORE_TEXT_POS_X 10
@@ -31,12 +30,16 @@
 #define PLAYER_SIZE 120.0
 #define PLAYER_SPEED 200.0f
 #define PLAYER_COLOR sf::Color::Blue
-#define MAX_LANE 2
+#define LANE_COUNT 3
+#define LANE_PACKAGE_RESERVE 256
 #define MIN_LANE 0
 #define PLAYER_OFFSET_Y -50.0f
 #define PACKAGE_SPAWN_INTERVAL_BASE 2.0f     
 #define PACKAGE_SPAWN_INTERVAL_DECREMENT 0.2f  
 #define PACKAGE_SPAWN_INTERVAL_MIN 0.5f        
 #define MAX_LIVES 3
+#define SIMULATION_STEP (1.0f / 60.0f)
+#define SIMULATION_MAX_CATCH_UP_STEPS 5
+#define INPUT_POLL_INTERVAL_US 1000
 
 #endif // CONSTANTS_H
\ No newline at end of file
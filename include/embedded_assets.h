@@ -0,0 +1,25 @@
+#ifndef EMBEDDED_ASSETS_H
+#define EMBEDDED_ASSETS_H
+
+#include <cstddef>
+#include <string>
+
+/**
+ * @struct EmbeddedAsset
+ * @brief Conteúdo de um arquivo de `assets/` embutido no executável.
+ *
+ * A tabela EMBEDDED_ASSETS é gerada pelo Makefile com tools/embed_assets.sh a partir dos arquivos
+ * de `assets/`; `path` é o caminho relativo usado nas constantes de constants.h.
+ */
+struct EmbeddedAsset {
+    const char *path;
+    const unsigned char *data;
+    std::size_t size;
+};
+
+extern const EmbeddedAsset EMBEDDED_ASSETS[];
+extern const std::size_t EMBEDDED_ASSET_COUNT;
+
+const EmbeddedAsset *findEmbeddedAsset(const std::string &path);
+
+#endif // EMBEDDED_ASSETS_H
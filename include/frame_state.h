@@ -0,0 +1,38 @@
+#ifndef FRAME_STATE_H
+#define FRAME_STATE_H
+
+#include <vector>
+
+class SimulationWorld;
+
+/**
+ * @struct LaneFrame
+ * @brief O que o Renderer precisa de uma esteira para desenhar um quadro.
+ */
+struct LaneFrame {
+    float y = 0.0f;
+    float packageY = 0.0f;
+    std::vector<float> packageXs;
+};
+
+/**
+ * @struct FrameState
+ * @brief Cópia imutável do estado visível do mundo em um instante, consumida pela thread de
+ *        renderização.
+ *
+ * A thread da simulação preenche um FrameState com capture() e o publica em um TripleBuffer; a
+ * thread de renderização desenha o mais recente sem tocar no SimulationWorld. Os vetores mantêm a
+ * capacidade entre capturas, de modo que capturar um quadro em regime permanente não aloca
+ * memória.
+ */
+struct FrameState {
+    std::vector<LaneFrame> lanes;
+    int playerLane = -1;
+    float playerX = 0.0f;
+    int score = 0;
+    int lives = 0;
+
+    void capture(SimulationWorld &world);
+};
+
+#endif // FRAME_STATE_H
@@ -2,87 +2,97 @@
 #define GAME_HH
 
 #include <SFML/Graphics.hpp>
-#include <random>
-
-#include <threadmill.h>
-#include <player.h>
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <thread>
+
+#include <autoplayer.h>
+#include <frame_state.h>
+#include <input_recording.h>
+#include <input_tracker.h>
+#include <latency_histogram.h>
+#include <renderer.h>
+#include <resource_cache.h>
+#include <simulation_world.h>
+#include <triple_buffer.h>
 
 /**
  * @class Game
  * @brief Classe responsável por gerenciar o ciclo de vida do jogo.
  *
- * A classe Game encapsula toda a lógica principal do jogo, incluindo a inicialização,
- * execução, atualização e renderização. Ela também gerencia os recursos do jogo,
- * como fontes e textos, e mantém o controle do estado do jogo, como pontuação e vidas.
+ * A classe Game é a interface com o usuário: ela abre a janela, traduz eventos de teclado em
+ * ações sobre o SimulationWorld e usa o Renderer para desenhar o estado do mundo a cada quadro.
+ * As regras do jogo (esteiras, pacotes, pontuação e vidas) vivem em SimulationWorld.
+ *
+ * Quando criada com um caminho de gravação, a partida usa um mundo sem threads (as esteiras
+ * avançam dentro de update()) e registra a semente e cada ação do jogador, marcada com o passo
+ * em que ocorreu, em uma InputRecording salva ao final; replayRecording() reproduz a partida.
+ * Com `autoplay`, um Autoplayer joga no lugar do teclado, e as suas ações são gravadas como as
+ * do jogador.
+ *
+ * Entre os passos da simulação a fila de eventos é lida a cada INPUT_POLL_INTERVAL_US
+ * microssegundos, e coletas e trocas de faixa são aplicadas assim que lidas; o estado das teclas
+ * de movimento vem dos próprios eventos, por meio de um InputTracker.
  *
- * @details
- * A classe Game contém métodos privados para carregar recursos, processar eventos,
- * atualizar o estado do jogo e renderizar a tela. Ela também gerencia a criação e
- * atualização de objetos do jogo, como esteiras e o jogador.
+ * O desenho acontece em uma thread própria: a thread principal lê os eventos, avança o mundo e
+ * publica, a cada passo, um FrameState em um TripleBuffer; a thread de renderização desenha
+ * sempre o quadro mais recente e é a única que espera pela tela.
+ *
+ * O tempo entre a criação do Game e a exibição do primeiro quadro é medido e informado no
+ * console, junto com o tempo gasto pelo ResourceCache para carregar os recursos.
  *
  * @note
  * Esta classe utiliza a biblioteca SFML para renderização e manipulação de eventos.
  *
- * @see Threadmill
- * @see Player
+ * @see SimulationWorld
+ * @see Renderer
  */
 class Game {
 public:
-    Game();
+    explicit Game(const std::string &recordPath = "", bool autoplay = false);
 
     ~Game();
 
     void run();
 
 private:
-    void loadAssets();
-
+    void waitForNextStep(SimulationClock::Clock::time_point deadline);
     void processEvents();
-    void handlePlayerAction(sf::Keyboard::Key key);
-
-    void collectPackage();
+    void handlePlayerAction(sf::Keyboard::Key key,
+                            std::chrono::steady_clock::time_point inputTime);
 
     void update(float deltaTime);
+    void recordInput(InputEvent::Type type, int value);
 
-    void spawnRandomPackage();
-
-    void render();
-    void updateScoreText();
-
-    void updateLivesText();
-
-    void updatePackageSpeed();
-    void updatePackageSpawnInterval();
-
-    void resetGame();
-
-    Threadmill* getThreadmillByLane(int lane);
-
-    void updateActiveThreadmills();
+    void publishFrame();
+    void startRendering();
+    void stopRendering();
+    void renderLoop();
+    void render(const FrameState &frame);
+    void reportStartup();
 
+    std::chrono::steady_clock::time_point startTime;
     sf::RenderWindow window;
-    sf::Font font;
-    sf::Text textScore;
-    sf::Text textLives;
-
-    int score;
-    int lives;
-
-    std::vector<int> laneYs = { THREADMILL_Y_POS_TOP, THREADMILL_Y_POS_CENTER, THREADMILL_Y_POS_BOTTOM };
-    Threadmill threadmillTop;
-    Threadmill threadmillCenter;
-    Threadmill threadmillBottom;
-    Player player;
-
-    std::mt19937 rng;
-    std::uniform_int_distribution<int> distLane;
-
-    sf::Clock spawnTimer;
-
-    float currentSpawnInterval;
-    int spawnIntervalSteps;
-
-    int nextId;
+    SimulationWorld world;
+    ResourceCache resources;
+    Renderer renderer;
+
+    InputTracker input;
+    bool autoplay;
+    Autoplayer autoplayer;
+    LatencyHistogram inputToCollectLatency;
+    std::chrono::steady_clock::time_point lastPoll;
+    uint64_t laneEventCounts[3] = {};
+
+    std::string recordPath;
+    InputRecording recording;
+    uint32_t tick;
+    int lastDirection;
+
+    TripleBuffer<FrameState> frames;
+    std::atomic<bool> rendering;
+    std::thread renderThread;
 };
 
-#endif // GAME_HH
\ No newline at end of file
+#endif // GAME_HH
@@ -0,0 +1,58 @@
+#ifndef INPUT_RECORDING_H
+#define INPUT_RECORDING_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @struct InputEvent
+ * @brief Uma ação do jogador, marcada com o passo fixo em que ocorreu.
+ *
+ * `tick` é o número de chamadas a SimulationWorld::update() feitas antes da ação. Para
+ * SWITCH_LANE, `value` é a direção (-1 ou 1); para MOVE, a nova direção horizontal (-1, 0 ou 1),
+ * registrada apenas quando muda; COLLECT não usa `value`.
+ */
+struct InputEvent {
+    enum Type : uint8_t { SWITCH_LANE, COLLECT, MOVE };
+
+    uint32_t tick;
+    Type type;
+    int8_t value;
+};
+
+/**
+ * @struct InputRecording
+ * @brief Sessão gravada: semente, ações do jogador e resultado final.
+ *
+ * Com a mesma semente e as mesmas ações aplicadas nos mesmos passos, um SimulationWorld sem
+ * threads reproduz exatamente a sessão. O arquivo é binário e compacto: um cabeçalho fixo seguido
+ * de 6 bytes por evento, todos os inteiros em little-endian.
+ */
+struct InputRecording {
+    uint32_t seed = 0;
+    uint32_t laneCount = 0;
+    uint32_t tickCount = 0;
+    int32_t finalScore = 0;
+    int32_t finalLives = 0;
+    std::vector<InputEvent> events;
+
+    bool save(const std::string &path) const;
+
+    bool load(const std::string &path);
+};
+
+/**
+ * @struct ReplayResult
+ * @brief Resultado de replayRecording(): estado final e tempo de CPU gasto.
+ */
+struct ReplayResult {
+    int score;
+    int lives;
+    uint32_t ticks;
+    double seconds;
+};
+
+ReplayResult replayRecording(const InputRecording &recording);
+
+#endif // INPUT_RECORDING_H
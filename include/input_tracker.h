@@ -0,0 +1,28 @@
+#ifndef INPUT_TRACKER_H
+#define INPUT_TRACKER_H
+
+#include <SFML/Graphics.hpp>
+#include <bitset>
+
+/**
+ * @class InputTracker
+ * @brief Estado do teclado mantido a partir dos eventos da janela.
+ *
+ * Em vez de consultar sf::Keyboard::isKeyPressed, que faz uma chamada ao sistema de janelas a
+ * cada tecla consultada, o estado de cada tecla é atualizado pelos eventos KeyPressed e
+ * KeyReleased já lidos da fila da janela. Quando a janela perde o foco todas as teclas são
+ * consideradas soltas, pois os eventos de soltura deixam de chegar.
+ */
+class InputTracker {
+public:
+    void handleEvent(const sf::Event &event);
+
+    bool isPressed(sf::Keyboard::Key key) const;
+
+    int getHorizontalDirection() const;
+
+private:
+    std::bitset<sf::Keyboard::KeyCount> pressed_;
+};
+
+#endif // INPUT_TRACKER_H
@@ -0,0 +1,50 @@
+#ifndef LANE_QUERY_H
+#define LANE_QUERY_H
+
+#include <cstddef>
+#include <utility>
+
+#include <constants.h>
+
+/**
+ * @brief Encontra, por busca binária, os pacotes de uma esteira cujo centro está em
+ *        `[leftX, rightX]`.
+ *
+ * Usa o mesmo critério de Player::canGrabPackage. Como os pacotes estão na ordem de entrada, que
+ * é a ordem decrescente de x, os pacotes procurados formam um intervalo contíguo de índices; o
+ * primeiro deles é o mais à frente na esteira.
+ *
+ * @param count Quantidade de pacotes.
+ * @param leftX Limite esquerdo do intervalo.
+ * @param rightX Limite direito do intervalo.
+ * @param xAt Função chamada como `xAt(std::size_t index)` que retorna a posição x do pacote.
+ * @return O intervalo `[first, last)` de índices, vazio se nenhum pacote estiver no intervalo.
+ */
+template <typename XAt>
+std::pair<std::size_t, std::size_t> findPackagesByCenter(std::size_t count, float leftX,
+                                                         float rightX, XAt &&xAt) {
+    auto centerAt = [&xAt](std::size_t index) { return xAt(index) + (PACKAGE_SIZE / 2.0f); };
+
+    std::size_t low = 0;
+    std::size_t high = count;
+    while (low < high) {
+        std::size_t middle = low + (high - low) / 2;
+        if (centerAt(middle) > rightX)
+            low = middle + 1;
+        else
+            high = middle;
+    }
+    std::size_t first = low;
+
+    high = count;
+    while (low < high) {
+        std::size_t middle = low + (high - low) / 2;
+        if (centerAt(middle) >= leftX)
+            low = middle + 1;
+        else
+            high = middle;
+    }
+    return {first, low};
+}
+
+#endif // LANE_QUERY_H
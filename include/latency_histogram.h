@@ -0,0 +1,41 @@
+#ifndef LATENCY_HISTOGRAM_H
+#define LATENCY_HISTOGRAM_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+/**
+ * @class LatencyHistogram
+ * @brief Histograma de latências com baldes em potências de dois, seguro para várias threads.
+ *
+ * O balde `b` conta as amostras com duração em `[2^(b-1), 2^b)` nanossegundos. record() é uma
+ * única soma atômica relaxada, barata o bastante para ser chamada em caminhos críticos; os
+ * percentis são aproximados pelo limite superior do balde.
+ */
+class LatencyHistogram {
+public:
+    static constexpr int BUCKET_COUNT = 40;
+
+    LatencyHistogram();
+
+    void record(std::chrono::nanoseconds latency);
+
+    void merge(const LatencyHistogram &other);
+
+    uint64_t getCount() const;
+
+    std::chrono::nanoseconds getMax() const;
+
+    std::chrono::nanoseconds percentile(double fraction) const;
+
+    std::string summary() const;
+
+private:
+    std::atomic<uint64_t> buckets_[BUCKET_COUNT];
+    std::atomic<uint64_t> count_;
+    std::atomic<uint64_t> maxNanoseconds_;
+};
+
+#endif // LATENCY_HISTOGRAM_H
@@ -0,0 +1,113 @@
+#ifndef MPSC_QUEUE_H
+#define MPSC_QUEUE_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @class MpscQueue
+ * @brief Fila limitada sem bloqueio com vários produtores e um consumidor.
+ *
+ * Cada posição do anel guarda um número de sequência que indica se ela está livre para o produtor
+ * da volta atual ou pronta para o consumidor. Um produtor reserva uma posição com um único
+ * compare-and-swap no índice de escrita, copia o valor e publica a posição; o consumidor lê as
+ * posições em ordem sem nenhuma operação atômica de leitura-modificação-escrita. Nenhum dos lados
+ * adquire mutex nem aloca memória.
+ *
+ * @note Existe exatamente um consumidor. `Capacity` deve ser uma potência de dois.
+ *
+ * @tparam T Tipo copiável dos elementos.
+ * @tparam Capacity Número máximo de elementos na fila.
+ */
+template <typename T, std::size_t Capacity> class MpscQueue {
+    static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0,
+                  "MpscQueue capacity must be a power of two");
+
+public:
+    MpscQueue() {
+        for (std::size_t i = 0; i < Capacity; ++i) {
+            cells_[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    /**
+     * @brief Insere um elemento no fim da fila.
+     *
+     * @param value O elemento a inserir.
+     * @return false se a fila estiver cheia; nesse caso nada é inserido.
+     */
+    bool tryPush(const T &value) {
+        uint64_t position = tail_.load(std::memory_order_relaxed);
+        for (;;) {
+            Cell &cell = cells_[position & MASK];
+            uint64_t sequence = cell.sequence.load(std::memory_order_acquire);
+            int64_t difference = static_cast<int64_t>(sequence - position);
+            if (difference == 0) {
+                if (tail_.compare_exchange_weak(position, position + 1,
+                                                std::memory_order_relaxed))
+                    break;
+            } else if (difference < 0) {
+                return false;
+            } else {
+                position = tail_.load(std::memory_order_relaxed);
+            }
+        }
+
+        Cell &cell = cells_[position & MASK];
+        cell.value = value;
+        cell.sequence.store(position + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Remove o elemento do início da fila.
+     *
+     * @param value Recebe o elemento removido.
+     * @return false se não houver elemento pronto.
+     */
+    bool tryPop(T &value) {
+        Cell &cell = cells_[head_ & MASK];
+        if (cell.sequence.load(std::memory_order_acquire) != head_ + 1)
+            return false;
+
+        value = cell.value;
+        cell.sequence.store(head_ + Capacity, std::memory_order_release);
+        ++head_;
+        return true;
+    }
+
+    /**
+     * @brief Indica se há elementos inseridos ainda não consumidos.
+     *
+     * Pode ser chamada de qualquer thread; o resultado é apenas uma indicação.
+     */
+    bool hasPending() const {
+        return tail_.load(std::memory_order_acquire) != consumed_.load(std::memory_order_acquire);
+    }
+
+    /**
+     * @brief Torna visível a outras threads a posição atual do consumidor.
+     *
+     * O consumidor chama esta função depois de aplicar os elementos removidos, para que
+     * hasPending() só indique a fila vazia quando o efeito deles já estiver feito.
+     */
+    void markConsumed() {
+        consumed_.store(head_, std::memory_order_release);
+    }
+
+private:
+    static constexpr uint64_t MASK = Capacity - 1;
+
+    struct Cell {
+        std::atomic<uint64_t> sequence;
+        T value;
+    };
+
+    Cell cells_[Capacity];
+    alignas(64) std::atomic<uint64_t> tail_{0};
+    alignas(64) uint64_t head_ = 0;
+    std::atomic<uint64_t> consumed_{0};
+};
+
+#endif // MPSC_QUEUE_H
@@ -1,21 +1,21 @@
 #ifndef PACKAGE_H
 #define PACKAGE_H
 
-#include <SFML/Graphics.hpp>
-
 /**
  * @class Package
- * @brief Representa um pacote que pode ser desenhado e atualizado em uma janela de renderização.
+ * @brief Representa um pacote em uma esteira em um instante: seu identificador e sua posição x.
+ *
+ * A classe Package é um valor compacto (8 bytes) usado para trocar pacotes entre a esteira e o
+ * restante do jogo, por exemplo o pacote retornado por Threadmill::tryCollect. Dados comuns a
+ * todos os pacotes de uma esteira, como a posição vertical e a velocidade, pertencem à
+ * Threadmill; as posições ao longo do tempo são calculadas pelo PackageStore.
  *
- * A classe Package encapsula as propriedades e comportamentos de um pacote, incluindo sua posição,
- * velocidade e forma gráfica. Ela fornece métodos para obter o ID do pacote, verificar sua validade,
- * atualizar sua posição com base no tempo decorrido, desenhá-lo em uma janela de renderização,
- * e ajustar sua velocidade. Além disso, a classe gerencia uma textura estática compartilhada entre
- * todas as instâncias de Package.
+ * @note A classe não depende da SFML: a forma gráfica do pacote é responsabilidade do Renderer,
+ *       que a deriva da posição x e dos parâmetros da esteira.
  */
 class Package {
 public:
-    Package(int id, float startX, float startY, float speed);
+    Package(int id, float x);
 
     Package();
 
@@ -23,26 +23,13 @@ public:
 
     bool isValid() const;
 
-    void update(float deltaTime);
-
-    void draw(sf::RenderWindow& window);
-
     float getX() const;
 
-    sf::FloatRect getBounds() const;
-
-    void setSpeed(float speed);
-
-    static bool loadTexture();
-
 private:
     int id_;
     float x_;
-    float y_;
-    float speed_;
-    sf::Sprite shape_;
-
-    static sf::Texture texture_;
 };
 
-#endif  // PACKAGE_H
\ No newline at end of file
+static_assert(sizeof(Package) == 8, "Package must stay a compact value type");
+
+#endif  // PACKAGE_H
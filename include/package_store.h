@@ -0,0 +1,128 @@
+#ifndef PACKAGE_STORE_H
+#define PACKAGE_STORE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+/**
+ * @class PackageStore
+ * @brief Fila circular (ring buffer) dos pacotes de uma esteira, em structure-of-arrays.
+ *
+ * Todos os pacotes de uma esteira andam à mesma velocidade, que só muda entre passos. Por isso a
+ * loja não guarda a posição de cada pacote: ela mantém um odômetro, a distância total percorrida
+ * pela esteira, e cada pacote guarda apenas o valor do odômetro quando entrou. A posição é
+ * `startX + (odômetro - entrada)`, calculada sob demanda por xAt().
+ *
+ * Os pacotes são mantidos na ordem de entrada na esteira, que é também a ordem decrescente de x.
+ * Pacotes entram no fim da fila e expiram pelo início, de modo que um passo custa O(1) mais o
+ * número de pacotes que saíram da esteira, e a busca por posição (findByCenter) é binária. Os ids
+ * também são crescentes na ordem de entrada, o que torna a busca de erase() binária.
+ *
+ * erase() não desloca os demais pacotes: o pacote do início sai da fila, e um pacote do meio
+ * apenas é marcado como removido e continua ocupando a sua posição até chegar ao início. Cada
+ * posição removida aponta para uma posição seguinte (uma floresta de union-find com compressão
+ * de caminho), de modo que nextPresent() pula sequências de removidos em tempo amortizado
+ * quase constante e remover custa O(log n), independentemente do tamanho da fila.
+ *
+ * Índices passados a idAt(), xAt() e isRemoved() são lógicos: 0 é o pacote mais à frente, que
+ * nunca está removido, e size() inclui as posições removidas que ainda não chegaram ao início.
+ * Cada posição também tem um número de sequência global, que só cresce e não muda quando o anel
+ * cresce: a fila ocupa as sequências `[getHead(), getTail())`. As sequências das últimas
+ * remoções do meio da fila ficam registradas (removedSequence()), o que permite a uma cópia da
+ * fila se atualizar apenas com o que mudou. A memória do anel só cresce (dobrando) quando ele
+ * enche e nunca é devolvida; com reserve() o pico esperado é alocado de uma vez e a esteira não
+ * aloca mais nada.
+ *
+ * @note A classe não é thread-safe; a sincronização é responsabilidade da Threadmill.
+ */
+class PackageStore {
+public:
+    PackageStore(float startX, float speed);
+
+    void reserve(std::size_t capacity);
+
+    void push(int id);
+
+    bool erase(int id);
+
+    void clear();
+
+    void setSpeed(float speed);
+
+    float getSpeed() const;
+
+    int advance(float deltaTime, float limitX);
+
+    /**
+     * @brief Como advance(deltaTime, limitX), chamando `onExpired(int id)` para cada pacote
+     *        removido, na ordem em que saem da esteira.
+     */
+    template <typename Fn> int advance(float deltaTime, float limitX, Fn &&onExpired) {
+        odometer_ += static_cast<double>(speed_) * deltaTime;
+
+        int expired = 0;
+        while (head_ != tail_ && xAt(0) > limitX) {
+            onExpired(idAt(0));
+            popFront();
+            ++expired;
+        }
+        return expired;
+    }
+
+    std::pair<std::size_t, std::size_t> findByCenter(float leftX, float rightX) const;
+
+    std::size_t nextPresent(std::size_t index);
+
+    std::size_t size() const;
+
+    std::size_t presentCount() const;
+
+    bool empty() const;
+
+    int idAt(std::size_t index) const;
+
+    bool isRemoved(std::size_t index) const;
+
+    float xAt(std::size_t index) const;
+
+    double getOdometer() const;
+
+    double entryAt(std::size_t index) const;
+
+    uint64_t getHead() const;
+
+    uint64_t getTail() const;
+
+    std::size_t capacity() const;
+
+    uint64_t getRemovalCount() const;
+
+    uint64_t removedSequence(uint64_t removal) const;
+
+    /// Quantas das últimas remoções do meio da fila ficam disponíveis em removedSequence().
+    static constexpr std::size_t REMOVAL_LOG_CAPACITY = 64;
+
+private:
+    std::size_t slot(uint64_t sequence) const;
+    void grow();
+    void popFront();
+
+    float startX_;
+    float speed_;
+    double odometer_;
+
+    std::vector<int> ids_;
+    std::vector<double> entries_;
+    /// Para cada posição, a sua própria sequência se o pacote está presente, ou uma sequência
+    /// posterior por onde continuar a procura se ele foi removido.
+    std::vector<uint64_t> links_;
+    uint64_t head_;
+    uint64_t tail_;
+    std::size_t present_;
+    std::vector<uint64_t> removalLog_;
+    uint64_t removals_;
+};
+
+#endif // PACKAGE_STORE_H
@@ -1,43 +1,39 @@
 #ifndef PLAYER_HH
 #define PLAYER_HH
 
-#include <SFML/Graphics.hpp>
-
 #include <constants.h>
 #include <package.h>
 
 /**
  * @class Player
  * @brief Representa um jogador no jogo.
- * 
- * A classe Player gerencia a posição e as ações do jogador, incluindo a troca de faixas, 
- * manipulação de entrada, desenho na tela e verificação de colisões com pacotes.
+ *
+ * A classe Player gerencia a posição e as ações do jogador, incluindo a troca de faixas,
+ * o movimento horizontal e a verificação de colisões com pacotes.
+ *
+ * @note A leitura do teclado e o desenho do operário ficam a cargo de Game e Renderer,
+ *       de modo que o jogador pode ser simulado sem janela.
  */
 class Player {
 public:
-    Player(const std::vector<int>& laneYs);
+    explicit Player(int laneCount = LANE_COUNT);
 
     void switchLane(int direction);
 
-    void handleInput(float deltaTime);
-
-    void draw(sf::RenderWindow& window);
+    void move(int direction, float deltaTime);
 
     float getLeftX() const;
 
     float getRightX() const;
-    
+
     bool canGrabPackage(const Package& package) const;
 
     int getCurrentLane() const;
 
-    static bool loadTexture();
 private:
-    sf::Sprite shape_;
-    std::vector<int> laneYs_;
+    float x_;
+    int laneCount_;
     int currentLane_;
-
-    static sf::Texture texture_;
 };
 
-#endif // PLAYER_HH
\ No newline at end of file
+#endif // PLAYER_HH
@@ -0,0 +1,69 @@
+#ifndef RENDERER_H
+#define RENDERER_H
+
+#include <SFML/Graphics.hpp>
+#include <memory>
+
+#include <frame_state.h>
+#include <resource_cache.h>
+#include <texture_atlas.h>
+
+/**
+ * @class Renderer
+ * @brief Desenha um FrameState em uma janela SFML.
+ *
+ * A classe Renderer concentra todos os recursos gráficos do jogo (fonte, texturas e sprites)
+ * e converte um FrameState, a cópia do estado visível do SimulationWorld, em chamadas de
+ * desenho. Como não acessa o mundo, pode ser usada por uma thread de renderização própria. As
+ * esteiras, pacotes e jogador não guardam nenhuma informação gráfica; suas transformações são
+ * derivadas aqui a cada quadro.
+ * A fonte e as imagens vêm de um ResourceCache, que as carrega em paralelo; as imagens são
+ * combinadas em um TextureAtlas.
+ *
+ * Esteiras, pacotes e jogador são desenhados em lote: a cada quadro seus quads são acumulados em
+ * um único sf::VertexArray, reaproveitado entre quadros, e enviados em uma única chamada com a
+ * textura do atlas. Apenas os textos usam outra textura, a da fonte.
+ *
+ * @see FrameState
+ * @see ResourceCache
+ */
+class Renderer {
+public:
+    Renderer();
+
+    bool loadAssets(ResourceCache &resources);
+
+    void draw(sf::RenderWindow &window, const FrameState &frame);
+
+private:
+    struct StackLabel {
+        float x;
+        float y;
+        int count;
+    };
+
+    void appendThreadmill(const LaneFrame &lane);
+    void appendPackages(const LaneFrame &lane);
+    void appendPlayer(const FrameState &frame);
+    void appendQuad(float x, float y, float width, float height, const sf::IntRect &textureRect);
+
+    void updateScoreText(int score);
+    void updateLivesText(int lives);
+
+    std::shared_ptr<const sf::Font> font_;
+    TextureAtlas atlas_;
+    sf::IntRect packageRect_;
+    sf::IntRect playerRect_;
+    sf::IntRect threadmillRect_;
+
+    sf::VertexArray sceneVertices_;
+    std::vector<StackLabel> stackLabels_;
+
+    sf::Text textScore_;
+    sf::Text textLives_;
+    sf::Text countText_;
+    int shownScore_;
+    int shownLives_;
+};
+
+#endif // RENDERER_H
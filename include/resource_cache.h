@@ -0,0 +1,86 @@
+#ifndef RESOURCE_CACHE_H
+#define RESOURCE_CACHE_H
+
+#include <SFML/Graphics.hpp>
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+#include <embedded_assets.h>
+
+/**
+ * @class ResourceCache
+ * @brief Cache central de imagens, texturas e fontes, indexado pelo caminho do arquivo.
+ *
+ * Os recursos são primeiro pedidos (requestImage, requestTexture, requestFont) e depois
+ * carregados todos de uma vez por loadPending(): a leitura e a decodificação dos arquivos (PNG e
+ * TTF) acontecem em paralelo em um WorkStealingPool temporário, e apenas o envio das imagens
+ * decodificadas para a GPU acontece na thread que chamou, que é a dona do contexto OpenGL da
+ * janela. Pedir o mesmo caminho mais de uma vez não gera uma segunda leitura. Imagens ficam na
+ * memória principal, sem textura, para serem combinadas depois, por exemplo em um TextureAtlas.
+ *
+ * Por padrão os recursos são decodificados a partir da cópia embutida no executável
+ * (EMBEDDED_ASSETS), sem acessar o disco; só caminhos que não foram embutidos são lidos do
+ * arquivo. Com setAssetDirectory(), todos os recursos passam a ser lidos de arquivos nesse
+ * diretório, o que permite trocá-los sem recompilar.
+ *
+ * getImage(), getTexture() e getFont() devolvem handles compartilhados; o recurso vive enquanto
+ * houver um handle ou o cache existir. Um recurso que falhou ao carregar continua disponível,
+ * vazio, como acontecia quando cada classe carregava os próprios arquivos.
+ *
+ * @note A classe não é thread-safe: pedidos e consultas devem vir da mesma thread.
+ */
+class ResourceCache {
+public:
+    void requestImage(const std::string &path);
+
+    void requestTexture(const std::string &path);
+
+    void requestFont(const std::string &path);
+
+    void setAssetDirectory(const std::string &directory);
+
+    bool loadPending();
+
+    std::shared_ptr<const sf::Image> getImage(const std::string &path);
+
+    std::shared_ptr<const sf::Texture> getTexture(const std::string &path);
+
+    std::shared_ptr<const sf::Font> getFont(const std::string &path);
+
+    std::size_t getLoadedCount() const;
+
+    double getLoadSeconds() const;
+
+private:
+    enum State { PENDING, READY, FAILED };
+
+    struct ImageEntry {
+        std::shared_ptr<sf::Image> image = std::make_shared<sf::Image>();
+        State state = PENDING;
+    };
+
+    struct TextureEntry {
+        std::shared_ptr<sf::Texture> texture = std::make_shared<sf::Texture>();
+        sf::Image image;
+        State state = PENDING;
+    };
+
+    struct FontEntry {
+        std::shared_ptr<sf::Font> font = std::make_shared<sf::Font>();
+        State state = PENDING;
+    };
+
+    const EmbeddedAsset *embeddedAsset(const std::string &path) const;
+    std::string filePath(const std::string &path) const;
+
+    std::string assetDirectory_;
+    std::unordered_map<std::string, ImageEntry> images_;
+    std::unordered_map<std::string, TextureEntry> textures_;
+    std::unordered_map<std::string, FontEntry> fonts_;
+    std::size_t loadedCount_ = 0;
+    double loadSeconds_ = 0.0;
+};
+
+#endif // RESOURCE_CACHE_H
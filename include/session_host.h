@@ -0,0 +1,83 @@
+#ifndef SESSION_HOST_H
+#define SESSION_HOST_H
+
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include <autoplayer.h>
+#include <simulation_world.h>
+#include <work_stealing_pool.h>
+
+/**
+ * @struct HostConfig
+ * @brief Parâmetros de um SessionHost.
+ *
+ * @param sessions Número de partidas independentes.
+ * @param ticks Passos fixos executados por partida em run().
+ * @param workerThreads Tamanho do pool compartilhado; 0 usa o número de núcleos da máquina.
+ * @param seed Semente da primeira partida; a partida `i` usa `seed + i` (ou 1, se a soma der 0).
+ * @param autoplay Se verdadeiro, cada partida é jogada por um Autoplayer em vez do jogador
+ *                 aleatório.
+ */
+struct HostConfig {
+    int sessions = 1000;
+    uint32_t ticks = 3600;
+    unsigned workerThreads = 0;
+    uint32_t seed = 1;
+    bool autoplay = false;
+};
+
+/**
+ * @struct HostResult
+ * @brief Resultado de SessionHost::run(): passos executados, tempo gasto, pontuação somada e a
+ *        maior pontuação entre as partidas.
+ */
+struct HostResult {
+    int sessions;
+    unsigned threads;
+    uint64_t steps;
+    double seconds;
+    int64_t totalScore;
+    int bestScore;
+};
+
+/**
+ * @class SessionHost
+ * @brief Executa muitas partidas independentes, sem janela, em um único processo.
+ *
+ * Cada partida é um SimulationWorld sem threads (WorldConfig::threadedLanes falso), com
+ * esteiras, jogador, pontuação e geração de pacotes próprios, e um jogador aleatório
+ * determinístico que troca de faixa, anda e tenta coletar pacotes; com HostConfig::autoplay, o
+ * jogador é um Autoplayer, que mantém as partidas na dificuldade máxima. Nenhuma partida cria
+ * threads: run() divide as partidas em lotes e os submete a um único WorkStealingPool, e cada
+ * tarefa avança as partidas do seu lote uma de cada vez, mantendo o estado de uma partida no
+ * cache enquanto ela executa seus passos.
+ *
+ * Todo o estado de uma partida é alocado na construção; avançar uma partida não aloca memória.
+ */
+class SessionHost {
+public:
+    explicit SessionHost(const HostConfig &config = HostConfig());
+
+    HostResult run();
+
+private:
+    struct Session {
+        explicit Session(const WorldConfig &config);
+
+        SimulationWorld world;
+        Autoplayer autoplayer;
+        std::minstd_rand rng;
+        int direction;
+    };
+
+    void stepSession(Session &session, float step) const;
+
+    HostConfig config_;
+    WorkStealingPool pool_;
+    std::vector<std::unique_ptr<Session>> sessions_;
+};
+
+#endif // SESSION_HOST_H
@@ -0,0 +1,55 @@
+#ifndef SIMULATION_CLOCK_H
+#define SIMULATION_CLOCK_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+#include <constants.h>
+
+/**
+ * @class SimulationClock
+ * @brief Relógio de passo fixo compartilhado pela simulação das esteiras e pelo loop do jogo.
+ *
+ * O relógio define uma grade de passos de duração fixa a partir de um instante inicial comum.
+ * Cada consumidor (a thread das esteiras e o loop principal) guarda o índice do último passo que
+ * executou e pergunta a stepsDue() quantos passos já venceram desde então; como todos os prazos
+ * são calculados a partir do mesmo instante inicial, atrasos não se acumulam. Quando um consumidor
+ * fica para trás, executa passos de recuperação até `maxCatchUpSteps` e descarta o restante.
+ *
+ * Os contadores de atraso são atômicos e agregam todos os consumidores.
+ */
+class SimulationClock {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    explicit SimulationClock(float stepSeconds = SIMULATION_STEP,
+                             int maxCatchUpSteps = SIMULATION_MAX_CATCH_UP_STEPS);
+
+    void start();
+
+    int stepsDue(uint64_t &tick);
+
+    void resync(uint64_t &tick) const;
+
+    Clock::time_point stepDeadline(uint64_t tick) const;
+
+    void sleepUntilStep(uint64_t tick) const;
+
+    float getStep() const;
+
+    uint64_t getOverruns() const;
+
+    uint64_t getDroppedSteps() const;
+
+private:
+    Clock::duration stepDuration_;
+    float stepSeconds_;
+    int maxCatchUpSteps_;
+    Clock::time_point epoch_;
+
+    std::atomic<uint64_t> overruns_;
+    std::atomic<uint64_t> droppedSteps_;
+};
+
+#endif // SIMULATION_CLOCK_H
@@ -0,0 +1,141 @@
+#ifndef SIMULATION_WORLD_H
+#define SIMULATION_WORLD_H
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include <player.h>
+#include <simulation_clock.h>
+#include <threadmill.h>
+#include <work_stealing_pool.h>
+
+/**
+ * @struct WorldConfig
+ * @brief Parâmetros de criação de um SimulationWorld.
+ *
+ * @param laneCount Número de esteiras.
+ * @param threadedLanes Se verdadeiro, as esteiras avançam em segundo plano em um pool de threads.
+ * @param workerThreads Tamanho do pool; 0 usa o número de núcleos da máquina.
+ * @param seed Semente do gerador de números aleatórios; 0 sorteia uma com std::random_device.
+ * @param packageReserve Pacotes reservados de antemão em cada esteira (ver Threadmill).
+ */
+struct WorldConfig {
+    int laneCount = LANE_COUNT;
+    bool threadedLanes = true;
+    unsigned workerThreads = 0;
+    uint32_t seed = 0;
+    std::size_t packageReserve = LANE_PACKAGE_RESERVE;
+};
+
+/**
+ * @class SimulationWorld
+ * @brief Estado e regras do jogo, independentes de janela e texturas.
+ *
+ * A classe SimulationWorld é dona das esteiras, dos pacotes, do jogador, da pontuação, das vidas
+ * e da lógica de geração de pacotes. Ela não inclui nenhum cabeçalho da SFML, de modo que pode ser
+ * executada em máquinas sem display e avançada tão rápido quanto a CPU permitir.
+ *
+ * @details
+ * Com `threadedLanes` verdadeiro uma thread de controle submete, a cada passo, uma tarefa por
+ * esteira ativa a um WorkStealingPool de tamanho fixo, de modo que o número de esteiras não
+ * determina o número de threads do processo. Os passos das esteiras seguem o SimulationClock do
+ * mundo, o mesmo que o Game usa para chamar update(), de modo que esteiras e regras do jogo
+ * avançam na mesma grade de passos fixos. Quando nenhuma esteira está ativa, a thread de controle
+ * dorme em uma espera atômica (futex) até a próxima ativação, em vez de acordar a cada passo.
+ * Com `threadedLanes` falso nenhuma thread é criada e a esteira ativa avança dentro de update(),
+ * tornando a simulação inteiramente dirigida pelo chamador: com a mesma semente e as mesmas
+ * chamadas, o resultado é sempre o mesmo (veja replayRecording).
+ *
+ * O relógio só começa a contar, e a thread de controle só é criada, em start(), que o consumidor
+ * chama quando está pronto para chamar update() a cada passo; assim o tempo gasto entre a
+ * construção e o início do jogo (por exemplo, carregando recursos) não vira passos atrasados.
+ *
+ * Os pacotes perdidos chegam das esteiras como LaneEvent, consumidos em lote por update(); um
+ * ouvinte registrado com setLaneEventListener() recebe todos os eventos, na thread de update(),
+ * por exemplo para análises por pacote.
+ *
+ * @see Threadmill
+ * @see Player
+ * @see WorkStealingPool
+ */
+class SimulationWorld {
+public:
+    explicit SimulationWorld(const WorldConfig &config = WorldConfig());
+    ~SimulationWorld();
+
+    void start();
+
+    void update(float deltaTime);
+
+    bool collectPackage();
+
+    void switchLane(int direction);
+
+    void movePlayer(int direction, float deltaTime);
+
+    void resetGame();
+
+    int getScore() const;
+
+    int getLives() const;
+
+    int getLaneCount() const;
+
+    uint32_t getSeed() const;
+
+    const Player &getPlayer() const;
+
+    SimulationClock &getClock();
+
+    void collectLaneSwitchLatency(LatencyHistogram &out) const;
+
+    uint64_t getDroppedLaneEvents() const;
+
+    using LaneEventListener = std::function<void(int lane, const LaneEvent &event)>;
+
+    void setLaneEventListener(LaneEventListener listener);
+
+    Threadmill *getThreadmillByLane(int lane);
+
+private:
+    void runLanes();
+    bool anyLaneActive() const;
+
+    void spawnRandomPackage();
+
+    void updatePackageSpeed();
+    void updatePackageSpawnInterval();
+
+    void updateActiveThreadmills();
+
+    WorldConfig config_;
+
+    int score_;
+    int lives_;
+
+    std::vector<std::unique_ptr<Threadmill>> lanes_;
+    Player player_;
+
+    std::mt19937 rng_;
+    std::uniform_int_distribution<int> distLane_;
+
+    float spawnElapsed_;
+    float currentSpawnInterval_;
+    int spawnIntervalSteps_;
+
+    int nextId_;
+
+    SimulationClock clock_;
+    std::unique_ptr<WorkStealingPool> pool_;
+    bool started_;
+    std::thread laneThread_;
+    std::atomic<bool> stopLanes_;
+    std::atomic<uint32_t> activationEpoch_;
+    LaneEventListener laneEventListener_;
+};
+
+#endif // SIMULATION_WORLD_H
@@ -0,0 +1,80 @@
+#ifndef SPSC_RING_H
+#define SPSC_RING_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @class SpscRing
+ * @brief Anel limitado sem bloqueio com um produtor e um consumidor.
+ *
+ * O produtor escreve na posição de `tail_` e a publica com uma escrita atômica; o consumidor lê
+ * todas as posições publicadas de uma vez com drain() e as libera com uma única escrita em
+ * `head_`. Os dois índices ficam em linhas de cache separadas, e o produtor guarda uma cópia de
+ * `head_` para só ler o índice do consumidor quando o anel parece cheio. Nenhum dos lados adquire
+ * mutex, executa leitura-modificação-escrita atômica ou aloca memória.
+ *
+ * @note Existe exatamente um consumidor. Vários produtores são permitidos desde que serializados
+ *       externamente (por exemplo, por um mutex). `Capacity` deve ser uma potência de dois.
+ *
+ * @tparam T Tipo copiável dos elementos.
+ * @tparam Capacity Número máximo de elementos no anel.
+ */
+template <typename T, std::size_t Capacity> class SpscRing {
+    static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0,
+                  "SpscRing capacity must be a power of two");
+
+public:
+    /**
+     * @brief Insere um elemento no fim do anel.
+     *
+     * @param value O elemento a inserir.
+     * @return false se o anel estiver cheio; nesse caso nada é inserido.
+     */
+    bool tryPush(const T &value) {
+        uint64_t tail = tail_.load(std::memory_order_relaxed);
+        if (tail - cachedHead_ == Capacity) {
+            cachedHead_ = head_.load(std::memory_order_acquire);
+            if (tail - cachedHead_ == Capacity)
+                return false;
+        }
+        slots_[tail & MASK] = value;
+        tail_.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Chama `fn(const T &)` para cada elemento publicado, em ordem, e os remove.
+     *
+     * Elementos inseridos durante a chamada ficam para a próxima.
+     *
+     * @return O número de elementos consumidos.
+     */
+    template <typename Fn> std::size_t drain(Fn &&fn) {
+        uint64_t head = head_.load(std::memory_order_relaxed);
+        uint64_t tail = tail_.load(std::memory_order_acquire);
+        for (uint64_t position = head; position != tail; ++position) {
+            fn(static_cast<const T &>(slots_[position & MASK]));
+        }
+        head_.store(tail, std::memory_order_release);
+        return static_cast<std::size_t>(tail - head);
+    }
+
+    /**
+     * @brief Indica se não há elementos publicados. Pode ser chamada de qualquer thread.
+     */
+    bool empty() const {
+        return head_.load(std::memory_order_acquire) == tail_.load(std::memory_order_acquire);
+    }
+
+private:
+    static constexpr uint64_t MASK = Capacity - 1;
+
+    T slots_[Capacity];
+    alignas(64) std::atomic<uint64_t> tail_{0};
+    uint64_t cachedHead_ = 0;
+    alignas(64) std::atomic<uint64_t> head_{0};
+};
+
+#endif // SPSC_RING_H
@@ -0,0 +1,44 @@
+#ifndef STACKING_H
+#define STACKING_H
+
+#include <cstddef>
+
+#include <constants.h>
+
+/**
+ * @brief Percorre os grupos de pacotes empilhados de uma esteira em uma única passada.
+ *
+ * Um grupo começa no pacote mais à esquerda ainda não agrupado e inclui todos os pacotes seguintes
+ * cujo centro está dentro de `[x, x + PACKAGE_SIZE]` desse primeiro pacote. Para cada grupo com
+ * mais de um pacote, `fn(topX, count)` é chamada com a posição do pacote mais à frente do grupo
+ * e a quantidade de pacotes.
+ *
+ * Como todos os pacotes de uma esteira entram em PACKAGE_START_X e compartilham a mesma
+ * velocidade, a ordem de entrada já é a ordem decrescente de x; por isso os pacotes são
+ * percorridos do último para o primeiro, sem ordenar e sem alocar memória.
+ *
+ * @param xs Posições x dos pacotes na ordem de entrada (x não crescente).
+ * @param count Quantidade de pacotes.
+ * @param fn Função chamada como `fn(float topX, int count)` para cada pilha.
+ */
+template <typename Fn> void forEachStack(const float *xs, std::size_t count, Fn &&fn) {
+    std::size_t i = count;
+    while (i > 0) {
+        float groupStart = xs[i - 1];
+        float groupEnd = groupStart + PACKAGE_SIZE;
+        std::size_t groupSize = 1;
+        --i;
+        while (i > 0) {
+            float centerX = xs[i - 1] + PACKAGE_SIZE / 2.0f;
+            if (centerX > groupEnd)
+                break;
+            ++groupSize;
+            --i;
+        }
+        if (groupSize > 1) {
+            fn(xs[i], static_cast<int>(groupSize));
+        }
+    }
+}
+
+#endif // STACKING_H
@@ -0,0 +1,44 @@
+#ifndef TEXTURE_ATLAS_H
+#define TEXTURE_ATLAS_H
+
+#include <SFML/Graphics.hpp>
+#include <memory>
+#include <string>
+#include <vector>
+
+/**
+ * @class TextureAtlas
+ * @brief Combina várias imagens em uma única textura e informa a região de cada uma.
+ *
+ * As imagens são registradas com add() e empacotadas por build() em prateleiras: ordenadas da
+ * mais alta para a mais baixa, são colocadas lado a lado até completar a largura do atlas, que é
+ * a menor potência de dois que comporta a imagem mais larga e a área total. Um pixel
+ * transparente separa as regiões para que a amostragem de uma não invada a vizinha.
+ *
+ * Com todas as imagens em uma textura, tudo o que as usa pode ser desenhado em um único
+ * sf::VertexArray, com uma troca de textura e uma chamada de desenho.
+ *
+ * @note build() envia a textura para a GPU e deve ser chamada na thread dona do contexto OpenGL.
+ */
+class TextureAtlas {
+public:
+    void add(const std::string &name, std::shared_ptr<const sf::Image> image);
+
+    bool build();
+
+    sf::IntRect getRect(const std::string &name) const;
+
+    const sf::Texture &getTexture() const;
+
+private:
+    struct Region {
+        std::string name;
+        std::shared_ptr<const sf::Image> image;
+        sf::IntRect rect;
+    };
+
+    std::vector<Region> regions_;
+    sf::Texture texture_;
+};
+
+#endif // TEXTURE_ATLAS_H
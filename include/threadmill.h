@@ -1,68 +1,235 @@
 #ifndef THREADMILL_H
 #define THREADMILL_H
 
-#include <SFML/Graphics.hpp>
-#include <map>
-#include <thread>
+#include <atomic>
+#include <cstdint>
 #include <mutex>
-#include <semaphore> 
+#include <optional>
+#include <vector>
 
+#include <latency_histogram.h>
+#include <mpsc_queue.h>
 #include <package.h>
+#include <package_store.h>
+#include <spsc_ring.h>
+#include <triple_buffer.h>
 #include <constants.h>
 
+/**
+ * @struct LaneSnapshot
+ * @brief Cópia imutável do conteúdo de uma esteira em um instante.
+ *
+ * Os pacotes aparecem na ordem de entrada na esteira. Em vez das posições, o snapshot guarda o
+ * odômetro da esteira e o valor dele na entrada de cada pacote (veja PackageStore); xAt() e
+ * positions() calculam as posições. Pacotes removidos do meio da esteira continuam ocupando a
+ * sua posição, com id INVALID (veja isRemoved()), até chegarem ao início; `packageCount` conta
+ * apenas os presentes. `epoch` cresce a cada publicação, permitindo ao leitor saber se o
+ * conteúdo mudou desde a última leitura.
+ *
+ * Como o PackageStore, o snapshot é um anel indexado pelas sequências `[head, tail)` das
+ * posições da esteira, de modo que a Threadmill o atualiza copiando apenas as posições que
+ * entraram e marcando as que foram removidas desde a última vez que escreveu nele;
+ * `removals` é o total de remoções do PackageStore já marcadas.
+ */
+struct LaneSnapshot {
+    uint64_t epoch = 0;
+    std::size_t packageCount = 0;
+    double odometer = 0.0;
+    uint64_t head = 0;
+    uint64_t tail = 0;
+    uint64_t removals = 0;
+    std::vector<int> ids;
+    std::vector<double> entries;
+
+    std::size_t size() const {
+        return static_cast<std::size_t>(tail - head);
+    }
+
+    int idAt(std::size_t index) const {
+        return ids[slot(index)];
+    }
+
+    bool isRemoved(std::size_t index) const {
+        return idAt(index) == INVALID;
+    }
+
+    float xAt(std::size_t index) const {
+        return PACKAGE_START_X + static_cast<float>(odometer - entries[slot(index)]);
+    }
+
+    /**
+     * @brief Preenche `out` com as posições x dos pacotes presentes, na ordem de entrada.
+     */
+    void positions(std::vector<float> &out) const {
+        out.clear();
+        for (std::size_t i = 0; i < size(); ++i) {
+            if (!isRemoved(i))
+                out.push_back(xAt(i));
+        }
+    }
+
+    /**
+     * @brief Posição no anel do índice lógico `index`. A capacidade é potência de dois.
+     */
+    std::size_t slot(std::size_t index) const {
+        return static_cast<std::size_t>((head + index) & (ids.size() - 1));
+    }
+};
+
+/**
+ * @struct LaneCommand
+ * @brief Alteração pendente nos pacotes de uma esteira, aplicada pela thread que a avança.
+ *
+ * `ADD_BATCH` adiciona `count` pacotes com ids consecutivos a partir de `id`.
+ */
+struct LaneCommand {
+    enum Type : uint8_t { ADD, ADD_BATCH, REMOVE, SET_SPEED, CLEAR };
+
+    Type type = ADD;
+    int id = 0;
+    int count = 0;
+    float speed = 0.0f;
+};
+
+/**
+ * @struct LaneEvent
+ * @brief Acontecimento com pacotes de uma esteira, publicado para a thread principal.
+ *
+ * `packageId` é o pacote afetado; um SPAWNED de addPackages() cobre `count` pacotes com ids
+ * consecutivos a partir dele, e os demais eventos têm `count` 1. Um EXPIRED com `packageId`
+ * INVALID resume, em `count`, expirações que não couberam no anel de eventos. `time` é o instante
+ * em que a esteira aplicou a mudança, em nanossegundos de std::chrono::steady_clock.
+ */
+struct LaneEvent {
+    enum Type : uint8_t { SPAWNED, EXPIRED, COLLECTED };
+
+    Type type = SPAWNED;
+    int packageId = 0;
+    int count = 1;
+    int64_t time = 0;
+};
+
 /**
  * @class Threadmill
  * @brief Classe que representa uma esteira transportadora de pacotes.
- * 
+ *
  * A classe Threadmill gerencia pacotes em uma esteira transportadora, permitindo adicionar, remover e ajustar a velocidade dos pacotes.
- * Também permite ativar e desativar a esteira, além de desenhar a esteira em uma janela gráfica.
- * 
- * @note Esta classe utiliza a biblioteca SFML para renderização gráfica.
- * 
+ * Os pacotes são guardados em um PackageStore, uma fila circular na ordem de entrada, com
+ * posições calculadas a partir do odômetro da esteira, que só avança enquanto ela está ativa.
+ * Um passo custa O(1) mais o número de pacotes que entraram e saíram da esteira.
+ * Também permite ativar e desativar a esteira.
+ *
+ * O estado de ativação é atômico e verificado pelo próprio step(): uma esteira desativada não move
+ * mais nenhum pacote a partir do retorno de deactivate(), mesmo que um passo já tenha sido agendado.
+ * O tempo entre activate() e o primeiro passo executado é registrado em um LatencyHistogram.
+ *
+ * addPackage(), addPackages(), removePackage(), setPackageSpeed() e clearPackages() não alteram os
+ * pacotes diretamente: apenas inserem um LaneCommand em uma MpscQueue, sem adquirir `mtx_`. Os
+ * comandos são aplicados em ordem, sempre sob `mtx_`, no início do próximo step(),
+ * applyCommands() ou tryCollect().
+ *
+ * Toda alteração nos pacotes publica um LaneSnapshot em um TripleBuffer, que a thread principal lê
+ * com acquireSnapshot() sem bloquear a thread da esteira e sem alocar memória. A publicação
+ * não copia a esteira inteira: cada buffer recebe apenas as posições que entraram e as remoções
+ * feitas desde a última vez que foi escrito, e nos passos sem mudanças apenas o odômetro.
+ *
+ * A entrada, a expiração e a coleta de cada pacote são publicadas como LaneEvent em um SpscRing,
+ * sempre sob `mtx_`, que serializa os produtores; a thread principal os consome em lote com
+ * drainEvents(), sem adquirir nenhum mutex. Se o anel encher, eventos são descartados e contados
+ * em getDroppedEvents(), mas expirações descartadas continuam contadas, para que as vidas do
+ * jogador nunca fiquem erradas.
+ *
+ * @note A esteira não possui thread própria: ela só avança por chamadas a step(), que o
+ *       SimulationWorld executa como tarefas de um WorkStealingPool (ou diretamente, no modo
+ *       sem threads). A esteira também não depende da SFML; o desenho é feito pelo Renderer a
+ *       partir dos snapshots.
+ *
  * @param y Posição vertical da esteira.
  * @param packageSpeed Velocidade inicial dos pacotes na esteira.
+ * @param packageReserve Número de pacotes para os quais a memória é reservada na construção.
  */
 class Threadmill {
 public:
-    Threadmill(int y, float packageSpeed);
-    ~Threadmill();
+    Threadmill(int y, float packageSpeed, std::size_t packageReserve = LANE_PACKAGE_RESERVE);
 
     void addPackage(int id);
+    void addPackages(int firstId, int count);
     void removePackage(int id);
     void setPackageSpeed(float newSpeed);
 
     void clearPackages();
-    void activate();
+    std::optional<Package> tryCollect(float leftX, float rightX);
+
+    bool hasPendingCommands() const;
+    void applyCommands();
+
+    bool activate();
 
     void deactivate();
-    int getAndResetLostPackages();
+    bool isActive() const;
+    const LatencyHistogram &getActivationLatency() const;
+
+    /**
+     * @brief Chama `fn(const LaneEvent &)` para cada evento publicado desde a última chamada.
+     *
+     * Expirações descartadas por falta de espaço no anel são entregues primeiro, resumidas em um
+     * único EXPIRED com `packageId` INVALID.
+     *
+     * @note Deve ser chamada por uma única thread consumidora (a thread principal do jogo).
+     *
+     * @return O número de eventos entregues.
+     */
+    template <typename Fn> std::size_t drainEvents(Fn &&fn) {
+        std::size_t delivered = 0;
+        int overflow = overflowExpired_.exchange(0, std::memory_order_acquire);
+        if (overflow > 0) {
+            LaneEvent summary;
+            summary.type = LaneEvent::EXPIRED;
+            summary.packageId = INVALID;
+            summary.count = overflow;
+            fn(static_cast<const LaneEvent &>(summary));
+            ++delivered;
+        }
+        return delivered + events_.drain(fn);
+    }
 
-    void draw(sf::RenderWindow& window, sf::Font& font);
+    uint64_t getDroppedEvents() const;
 
-    std::map<int, Package> getPackages();
+    void step(float deltaTime);
+
+    const LaneSnapshot &acquireSnapshot();
+
+    int getY() const;
+    float getPackageY() const;
 
-    static bool loadTexture();
 private:
-    void run();
+    static constexpr std::size_t COMMAND_CAPACITY = 256;
+    static constexpr std::size_t EVENT_CAPACITY = 256;
+
+    void enqueue(const LaneCommand &command);
+    bool drainCommands();
+    void applyCommand(const LaneCommand &command, int64_t now);
+    void emit(LaneEvent::Type type, int packageId, int count, int64_t now);
+    void updatePackages(float deltaTime);
+    void publishSnapshot();
 
-    std::map<int, Package> packages_;
+    PackageStore packages_;
     int y_;
-    float packageSpeed_;
-    sf::Sprite threadmillShape_;
-    static sf::Texture threadmillTexture_;
-    static bool loaded;
+    TripleBuffer<LaneSnapshot> snapshots_;
+    uint64_t snapshotEpoch_;
+    MpscQueue<LaneCommand, COMMAND_CAPACITY> commands_;
 
-    std::thread thread_;
     std::mutex mtx_;
-    std::binary_semaphore semaphore_; 
-    bool isActive_;
-    std::atomic<bool> stop_;
-    std::mutex lostMutex_;
-    int lostPackages_;
+    std::atomic<bool> isActive_;
+    std::atomic<int64_t> activatedAt_;
+    LatencyHistogram activationLatency_;
+    SpscRing<LaneEvent, EVENT_CAPACITY> events_;
+    std::atomic<int> overflowExpired_;
+    std::atomic<uint64_t> droppedEvents_;
 
 public:
     static const int width = THREADMILL_WIDTH;
     static const int height = THREADMILL_HEIGHT;
 };
 
-#endif  // THREADMILL_H
\ No newline at end of file
+#endif  // THREADMILL_H
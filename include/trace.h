@@ -0,0 +1,101 @@
+#ifndef TRACE_H
+#define TRACE_H
+
+/**
+ * @file trace.h
+ * @brief Instrumentação de trechos críticos: temporizadores de escopo e tempo de espera em mutex.
+ *
+ * As macros só geram código quando o projeto é compilado com `THREADMILL_TRACE` definido
+ * (`make trace`); caso contrário, TRACE_SCOPE e TRACE_THREAD_NAME desaparecem e TRACE_LOCK vira um
+ * std::lock_guard comum, sem nenhum custo.
+ *
+ * Cada thread grava seus eventos em um buffer circular próprio, sem sincronização com as demais;
+ * quando o buffer enche, os eventos mais antigos são sobrescritos. Ao final da execução os
+ * eventos podem ser exportados no formato `trace_event` do Chrome (chrome://tracing, Perfetto)
+ * ou em CSV.
+ *
+ * - TRACE_SCOPE(name): mede a duração do escopo atual.
+ * - TRACE_LOCK(guard, lockable, name): adquire o std::mutex `lockable` em um std::lock_guard
+ *   chamado `guard` e registra quanto tempo a thread esperou por ele.
+ * - TRACE_THREAD_NAME(name): nomeia a thread atual no trace exportado.
+ *
+ * @note Os nomes devem ser literais de string (ou ter duração estática).
+ */
+
+#ifdef THREADMILL_TRACE
+
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <string>
+
+namespace trace {
+
+enum class Category : uint8_t { SCOPE, LOCK_WAIT };
+
+void record(const char *name, Category category, int64_t startNs, int64_t durationNs);
+
+void setThreadName(const char *name);
+
+int64_t nowNs();
+
+bool dumpChromeJson(const std::string &path);
+
+bool dumpCsv(const std::string &path);
+
+/**
+ * @class ScopedTimer
+ * @brief Registra a duração do escopo em que foi criado.
+ */
+class ScopedTimer {
+public:
+    ScopedTimer(const char *name, Category category = Category::SCOPE)
+        : name_(name), category_(category), start_(nowNs()) {}
+
+    ~ScopedTimer() {
+        if (name_)
+            record(name_, category_, start_, nowNs() - start_);
+    }
+
+    /**
+     * @brief Registra o evento agora, em vez de no fim do escopo.
+     */
+    void stop() {
+        record(name_, category_, start_, nowNs() - start_);
+        name_ = nullptr;
+    }
+
+    ScopedTimer(const ScopedTimer &) = delete;
+    ScopedTimer &operator=(const ScopedTimer &) = delete;
+
+private:
+    const char *name_;
+    Category category_;
+    int64_t start_;
+};
+
+} // namespace trace
+
+#define TRACE_CONCAT_INNER(a, b) a##b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT_INNER(a, b)
+
+#define TRACE_SCOPE(name) trace::ScopedTimer TRACE_CONCAT(traceScope_, __LINE__)(name)
+
+#define TRACE_LOCK(guard, lockable, name)                                                          \
+    trace::ScopedTimer guard##Wait_(name, trace::Category::LOCK_WAIT);                             \
+    std::lock_guard<std::mutex> guard(lockable);                                                   \
+    guard##Wait_.stop()
+
+#define TRACE_THREAD_NAME(name) trace::setThreadName(name)
+
+#else
+
+#include <mutex>
+
+#define TRACE_SCOPE(name) ((void)0)
+#define TRACE_LOCK(guard, lockable, name) std::lock_guard<std::mutex> guard(lockable)
+#define TRACE_THREAD_NAME(name) ((void)0)
+
+#endif // THREADMILL_TRACE
+
+#endif // TRACE_H
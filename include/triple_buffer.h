@@ -0,0 +1,66 @@
+#ifndef TRIPLE_BUFFER_H
+#define TRIPLE_BUFFER_H
+
+#include <atomic>
+
+/**
+ * @class TripleBuffer
+ * @brief Buffer triplo sem bloqueio para publicar valores de um escritor para um leitor.
+ *
+ * O escritor preenche writeBuffer() e chama publish(); o leitor chama read() e obtém sempre o
+ * valor publicado mais recente, sem esperar pelo escritor e sem alocar memória. Os três buffers
+ * circulam entre os papéis de escrita, intermediário e leitura por meio de uma única troca atômica
+ * de índice, de modo que nenhum dos lados bloqueia o outro.
+ *
+ * @note Existe exatamente um leitor. Vários escritores são permitidos desde que serializados
+ *       externamente (por exemplo, por um mutex).
+ */
+template <typename T> class TripleBuffer {
+public:
+    T &writeBuffer() {
+        return buffers_[back_];
+    }
+
+    /**
+     * @brief Chama `fn(T &)` para cada um dos três buffers, por exemplo para reservar memória.
+     *
+     * @note Só pode ser usada antes de o buffer ser compartilhado entre threads.
+     */
+    template <typename Fn> void forEachBuffer(Fn &&fn) {
+        for (T &buffer : buffers_) {
+            fn(buffer);
+        }
+    }
+
+    /**
+     * @brief Publica o conteúdo de writeBuffer() e passa a escrever em um buffer livre.
+     */
+    void publish() {
+        unsigned previous = middle_.exchange(back_ | DIRTY, std::memory_order_acq_rel);
+        back_ = previous & INDEX_MASK;
+    }
+
+    /**
+     * @brief Retorna o valor publicado mais recente.
+     *
+     * A referência permanece válida até a próxima chamada de read().
+     */
+    const T &read() {
+        if (middle_.load(std::memory_order_relaxed) & DIRTY) {
+            unsigned previous = middle_.exchange(front_, std::memory_order_acq_rel);
+            front_ = previous & INDEX_MASK;
+        }
+        return buffers_[front_];
+    }
+
+private:
+    static constexpr unsigned INDEX_MASK = 0x3;
+    static constexpr unsigned DIRTY = 0x4;
+
+    T buffers_[3];
+    std::atomic<unsigned> middle_{1};
+    unsigned back_ = 0;
+    unsigned front_ = 2;
+};
+
+#endif // TRIPLE_BUFFER_H
@@ -0,0 +1,74 @@
+#ifndef WORK_STEALING_POOL_H
+#define WORK_STEALING_POOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @class WorkStealingPool
+ * @brief Pool de threads de tamanho fixo com roubo de tarefas entre as filas.
+ *
+ * Cada thread trabalhadora possui sua própria fila. Tarefas submetidas de fora do pool são
+ * distribuídas entre as filas em rodízio; tarefas submetidas por um trabalhador vão para a fila
+ * dele. Um trabalhador consome a própria fila pelo fim e, quando ela esvazia, rouba tarefas do
+ * início das filas dos outros. Trabalhadores sem tarefas dormem até que algo seja submetido.
+ * As filas mantêm sua capacidade, de modo que, depois de atingir o pico de tarefas simultâneas,
+ * submit() não aloca memória para tarefas que cabem no armazenamento interno de std::function.
+ *
+ * @note wait() bloqueia até que todas as tarefas submetidas tenham terminado; não deve ser
+ *       chamada de dentro de uma tarefa do próprio pool.
+ */
+class WorkStealingPool {
+public:
+    explicit WorkStealingPool(unsigned threadCount = std::thread::hardware_concurrency());
+    ~WorkStealingPool();
+
+    WorkStealingPool(const WorkStealingPool &) = delete;
+    WorkStealingPool &operator=(const WorkStealingPool &) = delete;
+
+    void submit(std::function<void()> task);
+
+    void wait();
+
+    unsigned size() const;
+
+private:
+    /**
+     * Fila de um trabalhador: o dono consome pelo fim, ladrões pelo início (`head`). É um vetor,
+     * e não um std::deque, para que a capacidade seja reaproveitada e submeter tarefas em regime
+     * permanente não aloque memória.
+     */
+    struct Worker {
+        std::mutex mtx;
+        std::vector<std::function<void()>> tasks;
+        std::size_t head = 0;
+
+        bool empty() const {
+            return head == tasks.size();
+        }
+    };
+
+    void workerLoop(unsigned index);
+    bool popLocal(unsigned index, std::function<void()> &task);
+    bool steal(unsigned thief, std::function<void()> &task);
+    static void releaseConsumed(Worker &worker);
+    void finishTask();
+
+    std::vector<std::unique_ptr<Worker>> workers_;
+    std::vector<std::thread> threads_;
+
+    std::atomic<unsigned> nextQueue_;
+    std::atomic<int> queued_;
+    std::atomic<int> unfinished_;
+    std::atomic<bool> stop_;
+
+    std::mutex sleepMutex_;
+    std::condition_variable wakeCv_;
+};
+
+#endif // WORK_STEALING_POOL_H
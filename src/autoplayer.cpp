@@ -0,0 +1,62 @@
+#include <limits>
+
+#include <autoplayer.h>
+#include <lane_query.h>
+#include <simulation_world.h>
+
+namespace {
+// Folga dentro do jogador antes de andar em direção ao pacote, para não oscilar a cada passo.
+constexpr float MOVE_MARGIN = PLAYER_SIZE / 4.0f;
+
+/// Índice do primeiro pacote não removido a partir de `index`, ou snapshot.size().
+std::size_t nextPresent(const LaneSnapshot &snapshot, std::size_t index) {
+    while (index < snapshot.size() && snapshot.isRemoved(index)) {
+        ++index;
+    }
+    return index;
+}
+} // namespace
+
+/**
+ * @brief Escolhe as ações do próximo passo.
+ *
+ * @param world O mundo em que o autoplayer joga.
+ * @return A troca de faixa, a coleta e a direção horizontal do passo.
+ */
+AutoplayerAction Autoplayer::decide(SimulationWorld &world) const {
+    AutoplayerAction action;
+    const Player &player = world.getPlayer();
+    float left = player.getLeftX();
+    float right = player.getRightX();
+    int lane = player.getCurrentLane();
+
+    const LaneSnapshot &current = world.getThreadmillByLane(lane)->acquireSnapshot();
+    auto xAt = [&current](std::size_t index) { return current.xAt(index); };
+    auto inReach = findPackagesByCenter(current.size(), left, right, xAt);
+    action.collect = nextPresent(current, inReach.first) < inReach.second;
+
+    std::size_t target = nextPresent(
+        current,
+        findPackagesByCenter(current.size(), std::numeric_limits<float>::lowest(), right, xAt)
+            .first);
+    if (target < current.size()) {
+        float center = current.xAt(target) + PACKAGE_SIZE / 2.0f;
+        if (center < left + MOVE_MARGIN)
+            action.direction = -1;
+        else if (center > right - MOVE_MARGIN)
+            action.direction = 1;
+        return action;
+    }
+
+    int busiest = lane;
+    std::size_t most = 0;
+    for (int other = 0; other < world.getLaneCount(); ++other) {
+        std::size_t count = world.getThreadmillByLane(other)->acquireSnapshot().packageCount;
+        if (other != lane && count > most) {
+            busiest = other;
+            most = count;
+        }
+    }
+    action.laneDirection = busiest < lane ? -1 : (busiest > lane ? 1 : 0);
+    return action;
+}
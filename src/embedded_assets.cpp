@@ -0,0 +1,15 @@
+#include <embedded_assets.h>
+
+/**
+ * @brief Procura o recurso embutido com o caminho informado.
+ *
+ * @param path Caminho relativo do arquivo, como em constants.h.
+ * @return O recurso, ou nullptr se nenhum arquivo com esse caminho foi embutido.
+ */
+const EmbeddedAsset *findEmbeddedAsset(const std::string &path) {
+    for (std::size_t i = 0; i < EMBEDDED_ASSET_COUNT; ++i) {
+        if (path == EMBEDDED_ASSETS[i].path)
+            return &EMBEDDED_ASSETS[i];
+    }
+    return nullptr;
+}
@@ -0,0 +1,29 @@
+#include <frame_state.h>
+#include <simulation_world.h>
+#include <trace.h>
+
+/**
+ * @brief Copia do mundo as posições dos pacotes de cada esteira, o jogador, a pontuação e as
+ *        vidas.
+ *
+ * As posições vêm do snapshot publicado por cada esteira, sem adquirir o mutex da simulação.
+ *
+ * @note Lê os snapshots das esteiras e, portanto, deve ser chamada sempre pela mesma thread.
+ */
+void FrameState::capture(SimulationWorld &world) {
+    TRACE_SCOPE("FrameState::capture");
+    lanes.resize(static_cast<std::size_t>(world.getLaneCount()));
+    for (int lane = 0; lane < world.getLaneCount(); ++lane) {
+        Threadmill *threadmill = world.getThreadmillByLane(lane);
+        LaneFrame &frame = lanes[static_cast<std::size_t>(lane)];
+        frame.y = static_cast<float>(threadmill->getY());
+        frame.packageY = threadmill->getPackageY();
+        threadmill->acquireSnapshot().positions(frame.packageXs);
+    }
+
+    const Player &player = world.getPlayer();
+    playerLane = player.getCurrentLane();
+    playerX = player.getLeftX();
+    score = world.getScore();
+    lives = world.getLives();
+}
@@ -1,88 +1,159 @@
+#include <algorithm>
+#include <cstdlib>
 #include <iostream>
 
 #include <game.h>
+#include <trace.h>
+
+namespace {
+/// Configuração do mundo: sem threads quando a partida é gravada, para que seja reproduzível.
+WorldConfig makeWorldConfig(bool recording) {
+    WorldConfig config;
+    config.threadedLanes = !recording;
+    return config;
+}
+} // namespace
 
 /**
  * @brief Construtor da classe Game.
- * 
- * Inicializa a janela do jogo, as esteiras, o jogador, o gerador de números aleatórios,
- * o temporizador de spawn e outras variáveis necessárias para o funcionamento do jogo.
- * 
+ *
+ * Inicializa a janela do jogo, o mundo simulado e o renderer.
+ *
  * - Configura a janela com limite de taxa de quadros.
- * - Inicializa a semente do gerador de números aleatórios.
- * - Carrega os recursos necessários.
- * - Inicializa a pontuação e vidas do jogador.
- * - Configura os textos de pontuação e vidas.
- * - Adiciona um pacote inicial à esteira central.
- * - Atualiza as esteiras ativas.
+ * - Carrega os recursos gráficos em paralelo pelo ResourceCache, a partir da cópia embutida no
+ *   executável ou, se a variável de ambiente `THREADMILL_ASSET_DIR` estiver definida, dos
+ *   arquivos nesse diretório.
+ * - Se `recordPath` não for vazio, prepara a gravação da partida com a semente do mundo.
+ * - Se `autoplay` for verdadeiro, as ações passam a ser decididas por um Autoplayer.
+ * - Reserva a memória dos FrameState, para que publicar quadros não aloque memória.
+ * - Conta os pacotes que entraram, foram coletados e expiraram a partir dos LaneEvent.
+ *
+ * @param recordPath Arquivo onde a partida será gravada; vazio para não gravar.
+ * @param autoplay Se verdadeiro, o Autoplayer joga no lugar do teclado.
  */
-Game::Game()
-    : window(sf::VideoMode(WIDTH, HEIGHT), "Threadmill: The Game"),
-      threadmillTop(THREADMILL_Y_POS_TOP, PACKAGE_SPEED_BASE),
-      threadmillCenter(THREADMILL_Y_POS_CENTER, PACKAGE_SPEED_BASE),
-      threadmillBottom(THREADMILL_Y_POS_BOTTOM, PACKAGE_SPEED_BASE), player(laneYs),
-      rng(std::random_device{}()), distLane(0, 2), spawnTimer(),
-      currentSpawnInterval(PACKAGE_SPAWN_INTERVAL_BASE), spawnIntervalSteps(0), nextId(1) {
+Game::Game(const std::string &recordPath, bool autoplay)
+    : startTime(std::chrono::steady_clock::now()),
+      window(sf::VideoMode(WIDTH, HEIGHT), "Threadmill: The Game"),
+      world(makeWorldConfig(!recordPath.empty())), autoplay(autoplay), recordPath(recordPath),
+      tick(0), lastDirection(0), rendering(false) {
     window.setFramerateLimit(60);
-    srand(time(NULL));
-    loadAssets();
-
-    score = SCORE_INITIAL;
-    lives = MAX_LIVES;
-
-    textScore.setFont(font);
-    textScore.setCharacterSize(SCORE_TEXT_SIZE);
-    textScore.setFillColor(sf::Color::White);
-    textScore.setPosition(SCORE_TEXT_POS_X, SCORE_TEXT_POS_Y);
-    updateScoreText();
-
-    textLives.setFont(font);
-    textLives.setCharacterSize(SCORE_TEXT_SIZE);
-    textLives.setFillColor(sf::Color::White);
-    textLives.setPosition(LIVES_TEXT_POS_X, LIVES_TEXT_POS_Y);
-    updateLivesText();
-
-    threadmillCenter.addPackage(nextId++);
-
-    updateActiveThreadmills();
+    if (const char *assetDirectory = std::getenv("THREADMILL_ASSET_DIR")) {
+        resources.setAssetDirectory(assetDirectory);
+    }
+    renderer.loadAssets(resources);
+    recording.seed = world.getSeed();
+    recording.laneCount = static_cast<uint32_t>(world.getLaneCount());
+    world.setLaneEventListener([this](int, const LaneEvent &event) {
+        laneEventCounts[event.type] += static_cast<uint64_t>(event.count);
+    });
+    frames.forEachBuffer([this](FrameState &frame) {
+        frame.lanes.resize(static_cast<std::size_t>(world.getLaneCount()));
+        for (LaneFrame &lane : frame.lanes) {
+            lane.packageXs.reserve(LANE_PACKAGE_RESERVE);
+        }
+    });
 }
 
-Game::~Game() {}
+Game::~Game() {
+    stopRendering();
+}
 
 /**
  * @brief Executa o loop principal do jogo.
- * 
- * Esta função inicia o relógio e entra em um loop que continua enquanto a janela estiver aberta.
- * Dentro do loop, calcula o tempo decorrido desde o último quadro, processa eventos, atualiza o estado do jogo
- * e renderiza o conteúdo na janela.
+ *
+ * Inicia a thread de renderização e o relógio do mundo (SimulationWorld::start) e marca a
+ * primeira leitura de eventos (`lastPoll`), de modo que o tempo gasto carregando recursos no
+ * construtor não conta como passos atrasados nem como latência de entrada, e entra em um
+ * loop que continua enquanto a janela estiver aberta. Dentro do loop, processa eventos, executa
+ * update() uma vez para cada passo fixo vencido no SimulationClock do mundo (o mesmo relógio que
+ * dirige as esteiras), publica um FrameState com o resultado e, até o próximo passo, continua
+ * lendo os eventos a cada INPUT_POLL_INTERVAL_US microssegundos (waitForNextStep). O desenho e a espera pela tela acontecem na thread de
+ * renderização, de modo que não atrasam a leitura dos eventos nem a simulação. Ao final, informa
+ * quantas vezes a simulação atrasou em relação ao relógio, a distribuição da latência entre a
+ * troca de faixa e o primeiro passo da nova esteira, quantos pacotes entraram, foram coletados e
+ * expiraram e a latência entre a leitura de uma tecla e a coleta do pacote, e salva a gravação,
+ * se houver.
  */
 void Game::run() {
-    sf::Clock clock;
+    SimulationClock &clock = world.getClock();
+    uint64_t clockTick = 0;
+    startRendering();
+    world.start();
+    lastPoll = std::chrono::steady_clock::now();
     while (window.isOpen()) {
-        float deltaTime = clock.restart().asSeconds();
         processEvents();
-        update(deltaTime);
-        render();
+        int steps = clock.stepsDue(clockTick);
+        for (int i = 0; i < steps; ++i) {
+            update(clock.getStep());
+        }
+        if (steps > 0) {
+            publishFrame();
+        }
+        waitForNextStep(clock.stepDeadline(clockTick));
+    }
+
+    std::cout << "Simulation clock: " << clock.getOverruns() << " overruns, "
+              << clock.getDroppedSteps() << " dropped steps." << std::endl;
+
+    LatencyHistogram laneSwitchLatency;
+    world.collectLaneSwitchLatency(laneSwitchLatency);
+    std::cout << "Lane switch latency: " << laneSwitchLatency.summary() << std::endl;
+    std::cout << "Lane events: " << laneEventCounts[LaneEvent::SPAWNED] << " spawned, "
+              << laneEventCounts[LaneEvent::COLLECTED] << " collected, "
+              << laneEventCounts[LaneEvent::EXPIRED] << " expired, "
+              << world.getDroppedLaneEvents() << " events dropped." << std::endl;
+    std::cout << "Input to collect latency: " << inputToCollectLatency.summary()
+              << " (upper bound from the previous poll; input polled every "
+              << INPUT_POLL_INTERVAL_US << " us)" << std::endl;
+
+    if (!recordPath.empty()) {
+        recording.tickCount = tick;
+        // Teclas lidas depois do último passo não afetaram a partida, e load() rejeita eventos
+        // com passo igual ou maior que tickCount.
+        while (!recording.events.empty() && recording.events.back().tick >= tick) {
+            recording.events.pop_back();
+        }
+        recording.finalScore = world.getScore();
+        recording.finalLives = world.getLives();
+        if (recording.save(recordPath)) {
+            std::cout << "Recorded " << recording.events.size() << " inputs over " << tick
+                      << " steps to " << recordPath << "." << std::endl;
+        } else {
+            std::cerr << "Could not write recording to " << recordPath << "." << std::endl;
+        }
     }
 }
 
 /**
- * @brief Carrega os recursos necessários para o jogo.
- * 
- * Esta função carrega a fonte e a textura do pacote. Se ocorrer um erro durante
- * o carregamento de qualquer um dos recursos, uma mensagem de erro será exibida
- * no console.
- * 
- * @note Certifique-se de que os caminhos dos arquivos de fonte e textura estão
- * corretos e que os arquivos existem no local especificado.
+ * @brief Informa o tempo até o primeiro quadro e quanto dele foi gasto carregando recursos.
+ *
+ * Chamada pela thread de renderização logo após exibir o primeiro quadro.
  */
-void Game::loadAssets() {
-    if (!font.loadFromFile(FONT_PATH)) {
-        std::cout << "Error loading font." << std::endl;
-    }
+void Game::reportStartup() {
+    std::chrono::duration<double, std::milli> firstFrame =
+        std::chrono::steady_clock::now() - startTime;
+    std::cout << "Startup: first frame after " << firstFrame.count() << " ms, "
+              << resources.getLoadedCount() << " assets loaded in "
+              << resources.getLoadSeconds() * 1000.0 << " ms." << std::endl;
+}
 
-    if (!Package::loadTexture()) {
-        std::cout << "Error loading package texture." << std::endl;
+/**
+ * @brief Lê os eventos da janela repetidamente até o prazo do próximo passo.
+ *
+ * Dorme em intervalos de INPUT_POLL_INTERVAL_US microssegundos e processa os eventos que chegaram
+ * em cada um, de modo que uma ação do jogador é aplicada ao mundo no máximo um intervalo depois
+ * de chegar à fila da janela, e não no início do passo seguinte.
+ *
+ * @param deadline Prazo absoluto do próximo passo do SimulationClock.
+ */
+void Game::waitForNextStep(SimulationClock::Clock::time_point deadline) {
+    const auto interval = std::chrono::microseconds(INPUT_POLL_INTERVAL_US);
+    while (window.isOpen()) {
+        auto now = SimulationClock::Clock::now();
+        if (now >= deadline)
+            break;
+        std::this_thread::sleep_until(std::min(deadline, now + interval));
+        processEvents();
     }
 }
 
@@ -90,17 +161,27 @@ void Game::loadAssets() {
  * @brief Processa os eventos da janela do jogo.
  *
  * Esta função verifica e processa todos os eventos que ocorrem na janela do jogo.
- * Se a janela for fechada, ela será encerrada. Se uma tecla for pressionada, 
- * a ação correspondente do jogador será tratada.
+ * Se a janela for fechada, ela será encerrada. Eventos de teclado atualizam o InputTracker
+ * e, se uma tecla for pressionada, a ação correspondente do jogador é aplicada imediatamente.
+ *
+ * A SFML não informa quando um evento chegou à fila; sabe-se apenas que foi depois da leitura
+ * anterior. Por isso a ação é marcada com o instante da leitura anterior (`lastPoll`), e a
+ * latência medida a partir dele é um limite superior, que inclui a espera entre as leituras.
  */
 void Game::processEvents() {
+    TRACE_SCOPE("Game::processEvents");
+    auto inputTime = lastPoll;
+    lastPoll = std::chrono::steady_clock::now();
     sf::Event event;
     while (window.pollEvent(event)) {
-        if (event.type == sf::Event::Closed)
+        if (event.type == sf::Event::Closed) {
+            stopRendering();
             window.close();
+        }
 
+        input.handleEvent(event);
         if (event.type == sf::Event::KeyPressed)
-            handlePlayerAction(event.key.code);
+            handlePlayerAction(event.key.code, inputTime);
     }
 }
 
@@ -111,262 +192,143 @@ void Game::processEvents() {
  * Dependendo da tecla pressionada, o jogador pode coletar um pacote ou mudar de faixa.
  *
  * @param key A tecla pressionada pelo jogador.
+ * @param inputTime Instante da leitura anterior da fila, antes do qual a tecla não tinha chegado;
+ *        uma coleta bem-sucedida registra em `inputToCollectLatency` o tempo entre esse instante
+ *        e a remoção do pacote.
  *
  * - Se a tecla for `sf::Keyboard::Space`, o jogador coleta um pacote.
  * - Se a tecla for `sf::Keyboard::W` ou `sf::Keyboard::Up`, o jogador muda para a faixa acima.
  * - Se a tecla for `sf::Keyboard::S` ou `sf::Keyboard::Down`, o jogador muda para a faixa abaixo.
  */
-void Game::handlePlayerAction(sf::Keyboard::Key key) {
+void Game::handlePlayerAction(sf::Keyboard::Key key,
+                              std::chrono::steady_clock::time_point inputTime) {
     if (key == sf::Keyboard::Space) {
-        collectPackage();
+        if (world.collectPackage()) {
+            inputToCollectLatency.record(std::chrono::steady_clock::now() - inputTime);
+        }
+        recordInput(InputEvent::COLLECT, 0);
     }
     if (key == sf::Keyboard::W || key == sf::Keyboard::Up) {
-        player.switchLane(-1);
-        updateActiveThreadmills();
+        world.switchLane(-1);
+        recordInput(InputEvent::SWITCH_LANE, -1);
     }
     if (key == sf::Keyboard::S || key == sf::Keyboard::Down) {
-        player.switchLane(1);
-        updateActiveThreadmills();
-    }
-}
-
-/**
- * @brief Coleta pacotes do threadmill atual.
- *
- * Esta função coleta pacotes do threadmill na mesma faixa que o jogador está atualmente.
- * Se o threadmill atual contiver pacotes válidos que o jogador pode pegar, o pacote é coletado,
- * a pontuação é incrementada, a velocidade dos pacotes e o intervalo de spawn são atualizados.
- * Em seguida, o pacote coletado é removido do threadmill e o texto da pontuação é atualizado.
- */
-void Game::collectPackage() {
-    int currentLane = player.getCurrentLane();
-    Threadmill *currentThreadmill = getThreadmillByLane(currentLane);
-    if (currentThreadmill) {
-        std::map<int, Package> packages = currentThreadmill->getPackages();
-        std::vector<int> collectedPackages;
-        for (auto &[id, package] : packages) {
-            if (package.isValid() && player.canGrabPackage(package)) {
-                collectedPackages.push_back(id);
-                score++;
-                updatePackageSpeed();
-                updatePackageSpawnInterval();
-                break;
-            }
-        }
-        for (int id : collectedPackages) {
-            currentThreadmill->removePackage(id);
-        }
-        updateScoreText();
+        world.switchLane(1);
+        recordInput(InputEvent::SWITCH_LANE, 1);
     }
 }
 
 /**
  * @brief Atualiza o estado do jogo.
  *
- * Esta função é chamada a cada frame para atualizar o estado do jogo com base no tempo decorrido.
- * Ela lida com a perda de pacotes, atualiza o número de vidas, reinicia o jogo se necessário,
- * processa a entrada do jogador e gera novos pacotes em intervalos regulares.
+ * Obtém do InputTracker a direção das teclas de movimento horizontal, move o jogador e
+ * avança o mundo simulado pelo tempo decorrido. No modo automático, a troca de faixa, a coleta e
+ * a direção vêm do Autoplayer e são gravadas como as ações do teclado. Conta os passos
+ * executados, que marcam o instante das ações gravadas.
  *
  * @param deltaTime O tempo decorrido desde a última atualização, em segundos.
  */
 void Game::update(float deltaTime) {
-    int totalLostPackages = 0;
-    totalLostPackages += threadmillTop.getAndResetLostPackages();
-    totalLostPackages += threadmillCenter.getAndResetLostPackages();
-    totalLostPackages += threadmillBottom.getAndResetLostPackages();
-
-    if (totalLostPackages > 0) {
-        lives -= totalLostPackages;
-        if (lives < 0)
-            lives = 0;
-        updateLivesText();
-
-        if (lives <= 0) {
-            resetGame();
+    TRACE_SCOPE("Game::update");
+    int direction = input.getHorizontalDirection();
+    if (autoplay) {
+        AutoplayerAction action = autoplayer.decide(world);
+        if (action.laneDirection != 0) {
+            world.switchLane(action.laneDirection);
+            recordInput(InputEvent::SWITCH_LANE, action.laneDirection);
+        }
+        if (action.collect) {
+            world.collectPackage();
+            recordInput(InputEvent::COLLECT, 0);
         }
+        direction = action.direction;
     }
-
-    player.handleInput(deltaTime);
-
-    if (spawnTimer.getElapsedTime().asSeconds() >= currentSpawnInterval) {
-        spawnRandomPackage();
-        spawnTimer.restart();
+    if (direction != lastDirection) {
+        recordInput(InputEvent::MOVE, direction);
+        lastDirection = direction;
     }
+    world.movePlayer(direction, deltaTime);
+
+    world.update(deltaTime);
+    ++tick;
 }
 
 /**
- * @brief Gera um pacote aleatório e o adiciona a uma das esteiras.
- *
- * Esta função gera um número aleatório e, com base no valor gerado,
- * adiciona um novo pacote a uma das três esteiras: superior, central ou inferior.
- * O pacote recebe um identificador único que é incrementado a cada novo pacote.
+ * @brief Registra uma ação do jogador no passo atual, se a partida estiver sendo gravada.
  */
-void Game::spawnRandomPackage() {
-    int x = rand();
-    if (x % 3 == 0) {
-        threadmillTop.addPackage(nextId++);
-    } else if (x % 3 == 1) {
-        threadmillCenter.addPackage(nextId++);
-    } else {
-        threadmillBottom.addPackage(nextId++);
+void Game::recordInput(InputEvent::Type type, int value) {
+    if (!recordPath.empty()) {
+        recording.events.push_back({tick, type, static_cast<int8_t>(value)});
     }
 }
 
 /**
- * @brief Renderiza o estado atual do jogo na janela.
- * 
- * Esta função limpa a janela com uma cor de fundo específica e desenha
- * os elementos do jogo, incluindo as partes do threadmill, o jogador,
- * a pontuação e as vidas restantes. Após desenhar todos os elementos,
- * a função exibe o conteúdo na janela.
+ * @brief Captura o estado visível do mundo e o publica para a thread de renderização.
  */
-void Game::render() {
-    sf::Color backgroundColor(36, 36, 52); // #507bba
-    window.clear(backgroundColor);
-
-    threadmillTop.draw(window, font);
-    threadmillCenter.draw(window, font);
-    threadmillBottom.draw(window, font);
-
-    player.draw(window);
-
-    window.draw(textScore);
-    window.draw(textLives);
-
-    window.display();
+void Game::publishFrame() {
+    frames.writeBuffer().capture(world);
+    frames.publish();
 }
 
 /**
- * @brief Atualiza o texto da pontuação com o valor atual da pontuação.
+ * @brief Publica o primeiro quadro e inicia a thread de renderização.
  *
- * Esta função define a string do objeto textScore para exibir a pontuação
- * atual do jogo. A pontuação é convertida para uma string e concatenada
- * com o prefixo "Score: ".
+ * O contexto OpenGL da janela é liberado nesta thread para ser ativado na de renderização.
  */
-void Game::updateScoreText() {
-    textScore.setString("Score: " + std::to_string(score));
+void Game::startRendering() {
+    publishFrame();
+    window.setActive(false);
+    rendering.store(true, std::memory_order_release);
+    renderThread = std::thread(&Game::renderLoop, this);
 }
 
 /**
- * @brief Atualiza o texto que exibe o número de vidas restantes.
+ * @brief Para a thread de renderização e espera que ela termine o quadro atual.
  *
- * Esta função atualiza o texto do objeto `textLives` para exibir o número
- * atual de vidas restantes no jogo. O texto é formatado como "Vidas: X",
- * onde X é o número de vidas.
+ * Deve ser chamada antes de fechar a janela. Chamadas repetidas não têm efeito.
  */
-void Game::updateLivesText() {
-    textLives.setString("Vidas: " + std::to_string(lives));
+void Game::stopRendering() {
+    rendering.store(false, std::memory_order_release);
+    if (renderThread.joinable()) {
+        renderThread.join();
+    }
 }
 
 /**
- * @brief Atualiza a velocidade dos pacotes na esteira.
+ * @brief Laço da thread de renderização.
  *
- * A velocidade dos pacotes é calculada com base em uma velocidade base,
- * incrementada por um valor que depende da pontuação atual do jogo.
- * A nova velocidade é então aplicada às três esteiras: superior, central e inferior.
+ * Ativa o contexto OpenGL da janela e, enquanto a renderização não for interrompida, desenha o
+ * FrameState publicado mais recente. A espera imposta pelo limite de quadros acontece em
+ * window.display(), nesta thread. Informa o tempo de inicialização após o primeiro quadro.
  */
-void Game::updatePackageSpeed() {
-    float newSpeed =
-        PACKAGE_SPEED_BASE + (static_cast<int>(score / SCORE_THRESHOLD) * PACKAGE_SPEED_INCREMENT);
-    threadmillTop.setPackageSpeed(newSpeed);
-    threadmillCenter.setPackageSpeed(newSpeed);
-    threadmillBottom.setPackageSpeed(newSpeed);
-}
-
-/**
- * @brief Atualiza o intervalo de spawn dos pacotes com base na pontuação atual.
- *
- * Esta função ajusta o intervalo de spawn dos pacotes conforme a pontuação do jogo aumenta.
- * A cada vez que a pontuação atinge um múltiplo do SCORE_THRESHOLD, o intervalo de spawn
- * é decrementado por PACKAGE_SPAWN_INTERVAL_DECREMENT, até um valor mínimo definido por 
- * PACKAGE_SPAWN_INTERVAL_MIN.
- *
- * @note Esta função deve ser chamada periodicamente para garantir que o intervalo de spawn
- * seja atualizado conforme a pontuação do jogo aumenta.
- */
-void Game::updatePackageSpawnInterval() {
-    while (score >= (spawnIntervalSteps + 1) * SCORE_THRESHOLD) {
-        currentSpawnInterval -= PACKAGE_SPAWN_INTERVAL_DECREMENT;
-        if (currentSpawnInterval < PACKAGE_SPAWN_INTERVAL_MIN) {
-            currentSpawnInterval = PACKAGE_SPAWN_INTERVAL_MIN;
+void Game::renderLoop() {
+    TRACE_THREAD_NAME("render");
+    window.setActive(true);
+    bool firstFrame = true;
+    while (rendering.load(std::memory_order_acquire)) {
+        render(frames.read());
+        if (firstFrame) {
+            reportStartup();
+            firstFrame = false;
         }
-        spawnIntervalSteps++;
     }
+    window.setActive(false);
 }
 
 /**
- * @brief Reinicia o estado do jogo para os valores iniciais.
- * 
- * Esta função redefine a pontuação, vidas e intervalos de spawn para os valores iniciais.
- * Além disso, limpa todos os pacotes das esteiras e adiciona um novo pacote na esteira central.
- * 
- * @details
- * - A pontuação é redefinida para SCORE_INITIAL.
- * - As vidas são redefinidas para MAX_LIVES.
- * - Atualiza os textos de pontuação e vidas na interface.
- * - Atualiza a velocidade dos pacotes.
- * - Define o intervalo de spawn atual para PACKAGE_SPAWN_INTERVAL_BASE.
- * - Limpa todos os pacotes das esteiras superior, central e inferior.
- * - Adiciona um novo pacote na esteira central com um novo identificador.
- */
-void Game::resetGame() {
-    score = SCORE_INITIAL;
-    lives = MAX_LIVES;
-    updateScoreText();
-    updateLivesText();
-
-    updatePackageSpeed();
-
-    currentSpawnInterval = PACKAGE_SPAWN_INTERVAL_BASE;
-    spawnIntervalSteps = 0;
-
-    threadmillTop.clearPackages();
-    threadmillCenter.clearPackages();
-    threadmillBottom.clearPackages();
-
-    threadmillCenter.addPackage(nextId++);
-}
-
-/**
- * @brief Retorna a esteira correspondente à faixa especificada.
+ * @brief Renderiza um quadro na janela.
  *
- * Esta função recebe um número de faixa (lane) e retorna um ponteiro para a
- * esteira correspondente. As faixas são mapeadas da seguinte forma:
- * - 0: Esteira superior
- * - 1: Esteira central
- * - 2: Esteira inferior
+ * Esta função limpa a janela com uma cor de fundo específica, desenha o quadro
+ * através do Renderer e exibe o conteúdo na janela.
  *
- * @param lane O número da faixa (0, 1 ou 2).
- * @return Um ponteiro para a esteira correspondente à faixa especificada,
- *         ou nullptr se a faixa for inválida.
+ * @param frame Estado do mundo publicado pela simulação.
  */
-Threadmill *Game::getThreadmillByLane(int lane) {
-    switch (lane) {
-    case 0:
-        return &threadmillTop;
-    case 1:
-        return &threadmillCenter;
-    case 2:
-        return &threadmillBottom;
-    default:
-        return nullptr;
-    }
-}
+void Game::render(const FrameState &frame) {
+    TRACE_SCOPE("Game::render");
+    sf::Color backgroundColor(36, 36, 52); // #507bba
+    window.clear(backgroundColor);
 
-/**
- * @brief Atualiza as esteiras rolantes ativas no jogo.
- *
- * Esta função desativa todas as esteiras rolantes (superior, central e inferior)
- * e ativa apenas a esteira rolante correspondente à faixa atual do jogador.
- */
-void Game::updateActiveThreadmills() {
-    threadmillTop.deactivate();
-    threadmillCenter.deactivate();
-    threadmillBottom.deactivate();
+    renderer.draw(window, frame);
 
-    int currentLane = player.getCurrentLane();
-    Threadmill *currentThreadmill = getThreadmillByLane(currentLane);
-    if (currentThreadmill) {
-        currentThreadmill->activate();
-    }
-}
\ No newline at end of file
+    window.display();
+}
@@ -0,0 +1,151 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <utility>
+
+#include <input_recording.h>
+#include <simulation_world.h>
+
+namespace {
+
+constexpr char MAGIC[4] = {'T', 'M', 'R', 'C'};
+constexpr uint32_t FORMAT_VERSION = 1;
+// Maior número de esteiras aceito em uma gravação; o jogo usa LANE_COUNT, bem abaixo disso.
+constexpr uint32_t MAX_LANE_COUNT = 64;
+
+void putU32(std::vector<unsigned char> &out, uint32_t value) {
+    for (int i = 0; i < 4; ++i) {
+        out.push_back(static_cast<unsigned char>(value >> (8 * i)));
+    }
+}
+
+uint32_t getU32(const unsigned char *in) {
+    return uint32_t(in[0]) | uint32_t(in[1]) << 8 | uint32_t(in[2]) << 16 | uint32_t(in[3]) << 24;
+}
+
+} // namespace
+
+/**
+ * @brief Grava a sessão em `path`.
+ *
+ * @return false se o arquivo não pôde ser escrito.
+ */
+bool InputRecording::save(const std::string &path) const {
+    std::vector<unsigned char> bytes(MAGIC, MAGIC + 4);
+    putU32(bytes, FORMAT_VERSION);
+    putU32(bytes, seed);
+    putU32(bytes, laneCount);
+    putU32(bytes, tickCount);
+    putU32(bytes, static_cast<uint32_t>(finalScore));
+    putU32(bytes, static_cast<uint32_t>(finalLives));
+    putU32(bytes, static_cast<uint32_t>(events.size()));
+    for (const InputEvent &event : events) {
+        putU32(bytes, event.tick);
+        bytes.push_back(event.type);
+        bytes.push_back(static_cast<unsigned char>(event.value));
+    }
+
+    std::FILE *file = std::fopen(path.c_str(), "wb");
+    if (!file)
+        return false;
+    bool written = std::fwrite(bytes.data(), 1, bytes.size(), file) == bytes.size();
+    return std::fclose(file) == 0 && written;
+}
+
+/**
+ * @brief Lê uma sessão gravada por save().
+ *
+ * O arquivo é lido em uma gravação local, copiada para este objeto apenas se for válida; em
+ * caso de falha o objeto não é alterado.
+ *
+ * @return false se o arquivo não existe, está truncado ou não é uma gravação reconhecida: o
+ *         número de esteiras não está entre 1 e MAX_LANE_COUNT, um evento tem tipo desconhecido
+ *         ou os passos dos eventos não são crescentes e menores que o número de passos gravado.
+ */
+bool InputRecording::load(const std::string &path) {
+    std::FILE *file = std::fopen(path.c_str(), "rb");
+    if (!file)
+        return false;
+    std::vector<unsigned char> bytes;
+    unsigned char buffer[4096];
+    std::size_t read;
+    while ((read = std::fread(buffer, 1, sizeof(buffer), file)) > 0) {
+        bytes.insert(bytes.end(), buffer, buffer + read);
+    }
+    std::fclose(file);
+
+    constexpr std::size_t HEADER_SIZE = 4 + 7 * 4;
+    constexpr std::size_t EVENT_SIZE = 6;
+    if (bytes.size() < HEADER_SIZE || !std::equal(MAGIC, MAGIC + 4, bytes.begin()) ||
+        getU32(&bytes[4]) != FORMAT_VERSION)
+        return false;
+
+    InputRecording loaded;
+    loaded.seed = getU32(&bytes[8]);
+    loaded.laneCount = getU32(&bytes[12]);
+    loaded.tickCount = getU32(&bytes[16]);
+    loaded.finalScore = static_cast<int32_t>(getU32(&bytes[20]));
+    loaded.finalLives = static_cast<int32_t>(getU32(&bytes[24]));
+    uint32_t eventCount = getU32(&bytes[28]);
+    bool validLanes = loaded.laneCount >= 1 && loaded.laneCount <= MAX_LANE_COUNT;
+    if (!validLanes || bytes.size() != HEADER_SIZE + std::size_t(eventCount) * EVENT_SIZE)
+        return false;
+
+    loaded.events.reserve(eventCount);
+    uint32_t previousTick = 0;
+    for (uint32_t i = 0; i < eventCount; ++i) {
+        const unsigned char *in = &bytes[HEADER_SIZE + i * EVENT_SIZE];
+        uint32_t tick = getU32(in);
+        if (in[4] > InputEvent::MOVE || tick < previousTick || tick >= loaded.tickCount)
+            return false;
+        previousTick = tick;
+        loaded.events.push_back({tick, static_cast<InputEvent::Type>(in[4]),
+                                 static_cast<int8_t>(in[5])});
+    }
+    *this = std::move(loaded);
+    return true;
+}
+
+/**
+ * @brief Reexecuta uma sessão gravada sem janela e sem esperar pelo relógio.
+ *
+ * Cria um SimulationWorld sem threads com a semente e o número de esteiras gravados e, para cada
+ * passo, aplica as ações registradas naquele passo e executa o mesmo movimento e update() que
+ * Game::update executou, tão rápido quanto a CPU permite.
+ *
+ * @param recording A sessão gravada.
+ * @return O estado final do mundo e o tempo gasto.
+ */
+ReplayResult replayRecording(const InputRecording &recording) {
+    WorldConfig config;
+    config.laneCount = static_cast<int>(recording.laneCount);
+    config.threadedLanes = false;
+    config.seed = recording.seed;
+    SimulationWorld world(config);
+    float step = world.getClock().getStep();
+
+    auto start = std::chrono::steady_clock::now();
+    std::size_t next = 0;
+    int direction = 0;
+    for (uint32_t tick = 0; tick < recording.tickCount; ++tick) {
+        for (; next < recording.events.size() && recording.events[next].tick == tick; ++next) {
+            const InputEvent &event = recording.events[next];
+            switch (event.type) {
+            case InputEvent::SWITCH_LANE:
+                world.switchLane(event.value);
+                break;
+            case InputEvent::COLLECT:
+                world.collectPackage();
+                break;
+            case InputEvent::MOVE:
+                direction = event.value;
+                break;
+            }
+        }
+        world.movePlayer(direction, step);
+        world.update(step);
+    }
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+    return {world.getScore(), world.getLives(), recording.tickCount, elapsed.count()};
+}
@@ -0,0 +1,36 @@
+#include <input_tracker.h>
+
+/**
+ * @brief Atualiza o estado das teclas com um evento da janela.
+ *
+ * Eventos que não são de teclado, exceto a perda de foco, são ignorados.
+ */
+void InputTracker::handleEvent(const sf::Event &event) {
+    if (event.type == sf::Event::LostFocus) {
+        pressed_.reset();
+        return;
+    }
+    if (event.type != sf::Event::KeyPressed && event.type != sf::Event::KeyReleased)
+        return;
+    if (event.key.code < 0 || event.key.code >= sf::Keyboard::KeyCount)
+        return;
+    pressed_[static_cast<std::size_t>(event.key.code)] = event.type == sf::Event::KeyPressed;
+}
+
+bool InputTracker::isPressed(sf::Keyboard::Key key) const {
+    return key >= 0 && key < sf::Keyboard::KeyCount && pressed_[static_cast<std::size_t>(key)];
+}
+
+/**
+ * @brief Direção horizontal pedida pelas teclas de movimento (A, D, Esquerda, Direita).
+ *
+ * @return -1 para a esquerda, 1 para a direita, 0 se nenhuma ou ambas estão pressionadas.
+ */
+int InputTracker::getHorizontalDirection() const {
+    int direction = 0;
+    if (isPressed(sf::Keyboard::A) || isPressed(sf::Keyboard::Left))
+        direction -= 1;
+    if (isPressed(sf::Keyboard::D) || isPressed(sf::Keyboard::Right))
+        direction += 1;
+    return direction;
+}
@@ -0,0 +1,89 @@
+#include <algorithm>
+#include <bit>
+#include <cstdio>
+
+#include <latency_histogram.h>
+
+LatencyHistogram::LatencyHistogram() : count_(0), maxNanoseconds_(0) {
+    for (auto &bucket : buckets_) {
+        bucket.store(0, std::memory_order_relaxed);
+    }
+}
+
+/**
+ * @brief Registra uma amostra de latência.
+ *
+ * @param latency A duração medida; valores negativos contam como zero.
+ */
+void LatencyHistogram::record(std::chrono::nanoseconds latency) {
+    uint64_t ns = latency.count() > 0 ? static_cast<uint64_t>(latency.count()) : 0;
+    int bucket = std::bit_width(ns);
+    if (bucket >= BUCKET_COUNT)
+        bucket = BUCKET_COUNT - 1;
+    buckets_[bucket].fetch_add(1, std::memory_order_relaxed);
+    count_.fetch_add(1, std::memory_order_relaxed);
+
+    uint64_t previous = maxNanoseconds_.load(std::memory_order_relaxed);
+    while (ns > previous &&
+           !maxNanoseconds_.compare_exchange_weak(previous, ns, std::memory_order_relaxed)) {
+    }
+}
+
+/**
+ * @brief Soma as amostras de outro histograma a este.
+ */
+void LatencyHistogram::merge(const LatencyHistogram &other) {
+    for (int i = 0; i < BUCKET_COUNT; ++i) {
+        buckets_[i].fetch_add(other.buckets_[i].load(std::memory_order_relaxed),
+                              std::memory_order_relaxed);
+    }
+    count_.fetch_add(other.getCount(), std::memory_order_relaxed);
+    uint64_t otherMax = static_cast<uint64_t>(other.getMax().count());
+    uint64_t previous = maxNanoseconds_.load(std::memory_order_relaxed);
+    while (otherMax > previous &&
+           !maxNanoseconds_.compare_exchange_weak(previous, otherMax, std::memory_order_relaxed)) {
+    }
+}
+
+uint64_t LatencyHistogram::getCount() const {
+    return count_.load(std::memory_order_relaxed);
+}
+
+std::chrono::nanoseconds LatencyHistogram::getMax() const {
+    return std::chrono::nanoseconds(maxNanoseconds_.load(std::memory_order_relaxed));
+}
+
+/**
+ * @brief Retorna o limite superior do balde que contém o percentil pedido.
+ *
+ * @param fraction Fração entre 0 e 1 (por exemplo, 0.99 para o p99).
+ * @return A latência aproximada do percentil, ou zero se não houver amostras.
+ */
+std::chrono::nanoseconds LatencyHistogram::percentile(double fraction) const {
+    uint64_t total = getCount();
+    if (total == 0)
+        return std::chrono::nanoseconds(0);
+
+    uint64_t rank = static_cast<uint64_t>(fraction * static_cast<double>(total - 1)) + 1;
+    uint64_t seen = 0;
+    for (int i = 0; i < BUCKET_COUNT; ++i) {
+        seen += buckets_[i].load(std::memory_order_relaxed);
+        if (seen >= rank) {
+            uint64_t upper = i == 0 ? 0 : (uint64_t(1) << i) - 1;
+            return std::chrono::nanoseconds(std::min(upper, static_cast<uint64_t>(getMax().count())));
+        }
+    }
+    return getMax();
+}
+
+/**
+ * @brief Resumo textual: número de amostras, p50, p90, p99 e máximo em microssegundos.
+ */
+std::string LatencyHistogram::summary() const {
+    auto us = [](std::chrono::nanoseconds ns) { return ns.count() / 1000.0; };
+    char buffer[160];
+    std::snprintf(buffer, sizeof(buffer), "n=%llu p50=%.1fus p90=%.1fus p99=%.1fus max=%.1fus",
+                  static_cast<unsigned long long>(getCount()), us(percentile(0.50)),
+                  us(percentile(0.90)), us(percentile(0.99)), us(getMax()));
+    return buffer;
+}
@@ -1,7 +1,128 @@
+#include <climits>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+
 #include <game.h>
+#include <input_recording.h>
+#include <session_host.h>
+#include <trace.h>
+
+/**
+ * @brief Reproduz uma partida gravada sem janela e compara o resultado com o gravado.
+ *
+ * @return 0 se pontuação e vidas coincidem com a gravação, 1 caso contrário.
+ */
+static int runReplay(const char *path) {
+    InputRecording recording;
+    if (!recording.load(path)) {
+        std::cerr << "Could not read recording " << path << "." << std::endl;
+        return 1;
+    }
+
+    ReplayResult result = replayRecording(recording);
+    bool matches = result.score == recording.finalScore && result.lives == recording.finalLives;
+    std::cout << "Replayed " << result.ticks << " steps in " << result.seconds * 1000.0
+              << " ms (" << result.ticks / result.seconds << " steps/s): score " << result.score
+              << ", lives " << result.lives << (matches ? " (matches recording)." : "")
+              << std::endl;
+    if (!matches) {
+        std::cout << "Recording ended with score " << recording.finalScore << ", lives "
+                  << recording.finalLives << "." << std::endl;
+    }
+    return matches ? 0 : 1;
+}
+
+/**
+ * @brief Executa `sessions` partidas sem janela em um SessionHost e mostra os passos por segundo.
+ */
+static int runHost(const char *sessions, bool autoplay) {
+    HostConfig config;
+    char *end = nullptr;
+    long count = std::strtol(sessions, &end, 10);
+    config.sessions = count > 0 && count <= INT_MAX ? static_cast<int>(count) : 0;
+    config.autoplay = autoplay;
+    if (config.sessions <= 0 || end == sessions || *end != '\0') {
+        std::cerr << "Invalid session count " << sessions << "." << std::endl;
+        return 1;
+    }
+
+    SessionHost host(config);
+    HostResult result = host.run();
+    std::cout << "Ran " << result.sessions << " sessions x " << config.ticks << " steps on "
+              << result.threads << " threads in " << result.seconds * 1000.0 << " ms ("
+              << result.steps / result.seconds << " steps/s, total score " << result.totalScore
+              << ", best score " << result.bestScore << ")." << std::endl;
+    return 0;
+}
+
+#ifdef THREADMILL_TRACE
+/**
+ * @brief Grava o trace ao sair de main(), em qualquer modo (jogo, `--replay` ou `--host`).
+ */
+struct TraceDump {
+    ~TraceDump() {
+        trace::dumpChromeJson("threadmill_trace.json");
+        trace::dumpCsv("threadmill_trace.csv");
+    }
+};
+#endif
+
+/**
+ * @brief Mostra as formas de uso aceitas por main().
+ *
+ * @return 1, o código de saída para argumentos inválidos.
+ */
+static int printUsage(const char *program) {
+    std::cerr << "Usage: " << program << " [--record <file>] [--autoplay]\n"
+              << "       " << program << " --replay <file>\n"
+              << "       " << program << " --host <sessions> [--autoplay]" << std::endl;
+    return 1;
+}
+
+/**
+ * @brief Ponto de entrada.
+ *
+ * - Sem argumentos: abre o jogo.
+ * - `--record <arquivo>`: abre o jogo e grava a partida.
+ * - `--replay <arquivo>`: reproduz uma partida gravada sem janela, o mais rápido possível.
+ * - `--host <partidas>`: executa várias partidas independentes sem janela, em um pool de threads.
+ * - `--autoplay`, sozinho ou após `--record <arquivo>`: o Autoplayer joga no lugar do teclado;
+ *   após `--host <partidas>`, as partidas sem janela também são jogadas pelo Autoplayer.
+ *
+ * Qualquer outra combinação, como uma opção desconhecida ou `--record`, `--replay` e `--host`
+ * sem o valor, mostra o uso e termina com código 1 sem abrir a janela.
+ */
+int main(int argc, char **argv) {
+#ifdef THREADMILL_TRACE
+    TraceDump traceDump;
+#endif
+    TRACE_THREAD_NAME("main");
+    const char *program = argc > 0 ? argv[0] : "exec";
+    bool autoplay = argc > 1 && std::strcmp(argv[argc - 1], "--autoplay") == 0;
+    // Argumentos antes de um `--autoplay` final: nenhum, ou uma opção seguida do seu valor.
+    int optionArgs = argc - 1 - (autoplay ? 1 : 0);
+    if (optionArgs != 0 && optionArgs != 2) {
+        return printUsage(program);
+    }
+
+    const char *recordPath = "";
+    if (optionArgs == 2) {
+        if (std::strcmp(argv[1], "--replay") == 0 && !autoplay) {
+            return runReplay(argv[2]);
+        }
+        if (std::strcmp(argv[1], "--host") == 0) {
+            return runHost(argv[2], autoplay);
+        }
+        if (std::strcmp(argv[1], "--record") != 0) {
+            return printUsage(program);
+        }
+        recordPath = argv[2];
+    }
 
-int main() {
-    Game game;
-    game.run();
+    {
+        Game game(recordPath, autoplay);
+        game.run();
+    }
     return 0;
 }
\ No newline at end of file
@@ -0,0 +1,284 @@
+#include <algorithm>
+
+#include <constants.h>
+#include <lane_query.h>
+#include <package_store.h>
+
+namespace {
+constexpr std::size_t INITIAL_CAPACITY = 16;
+}
+
+/**
+ * @brief Construtor da classe PackageStore.
+ *
+ * @param startX Posição x em que os pacotes entram na esteira.
+ * @param speed Velocidade inicial da esteira.
+ */
+PackageStore::PackageStore(float startX, float speed)
+    : startX_(startX), speed_(speed), odometer_(0.0), head_(0), tail_(0), present_(0),
+      removalLog_(REMOVAL_LOG_CAPACITY), removals_(0) {}
+
+/**
+ * @brief Garante espaço para `capacity` pacotes sem novas alocações.
+ *
+ * A capacidade é arredondada para a próxima potência de dois.
+ */
+void PackageStore::reserve(std::size_t capacity) {
+    while (ids_.size() < capacity) {
+        grow();
+    }
+}
+
+/**
+ * @brief Adiciona um pacote ao final da esteira, na posição inicial.
+ *
+ * @note O id deve ser maior que o de todos os pacotes já presentes.
+ *
+ * @param id Identificador único do pacote.
+ */
+void PackageStore::push(int id) {
+    if (tail_ - head_ == ids_.size()) {
+        grow();
+    }
+    std::size_t tail = slot(tail_);
+    ids_[tail] = id;
+    entries_[tail] = odometer_;
+    links_[tail] = tail_;
+    ++tail_;
+    ++present_;
+}
+
+/**
+ * @brief Remove o pacote com o identificador informado, preservando a ordem dos demais.
+ *
+ * O pacote é localizado por busca binária nos ids. Se ele é o primeiro da fila, sai dela junto
+ * com os removidos que o seguem; caso contrário, a sua posição apenas passa a apontar para a
+ * seguinte. Nenhum outro pacote é deslocado.
+ *
+ * @param id O identificador do pacote a ser removido.
+ * @return true se o pacote existia, false caso contrário.
+ */
+bool PackageStore::erase(int id) {
+    std::size_t count = size();
+    std::size_t low = 0;
+    std::size_t high = count;
+    while (low < high) {
+        std::size_t middle = low + (high - low) / 2;
+        if (idAt(middle) < id)
+            low = middle + 1;
+        else
+            high = middle;
+    }
+    if (low == count || idAt(low) != id || isRemoved(low))
+        return false;
+
+    if (low == 0) {
+        popFront();
+    } else {
+        uint64_t sequence = head_ + low;
+        links_[slot(sequence)] = sequence + 1;
+        --present_;
+        removalLog_[removals_++ & (REMOVAL_LOG_CAPACITY - 1)] = sequence;
+    }
+    return true;
+}
+
+/**
+ * @brief Remove todos os pacotes. O odômetro continua de onde estava.
+ */
+void PackageStore::clear() {
+    head_ = tail_;
+    present_ = 0;
+}
+
+/**
+ * @brief Troca a velocidade da esteira a partir do próximo passo.
+ *
+ * As posições atuais não mudam, pois dependem apenas da distância já percorrida.
+ */
+void PackageStore::setSpeed(float speed) {
+    speed_ = speed;
+}
+
+float PackageStore::getSpeed() const {
+    return speed_;
+}
+
+/**
+ * @brief Avança a esteira e remove os pacotes que ultrapassaram `limitX`.
+ *
+ * Soma `speed * deltaTime` ao odômetro e retira do início da fila os pacotes cuja posição passou
+ * do limite; como a ordem de entrada é a ordem decrescente de x, a busca para no primeiro pacote
+ * que ainda está na esteira.
+ *
+ * @param deltaTime O tempo simulado do passo, em segundos.
+ * @param limitX Posição a partir da qual o pacote é considerado perdido.
+ * @return O número de pacotes removidos.
+ */
+int PackageStore::advance(float deltaTime, float limitX) {
+    return advance(deltaTime, limitX, [](int) {});
+}
+
+/**
+ * @brief Índices lógicos das posições cujo centro está em `[leftX, rightX]`.
+ *
+ * O intervalo pode incluir posições removidas; use nextPresent() para chegar ao primeiro pacote
+ * presente.
+ *
+ * @see findPackagesByCenter
+ */
+std::pair<std::size_t, std::size_t> PackageStore::findByCenter(float leftX, float rightX) const {
+    return findPackagesByCenter(size(), leftX, rightX,
+                                [this](std::size_t index) { return xAt(index); });
+}
+
+/**
+ * @brief Índice do primeiro pacote presente a partir de `index`, ou size() se não houver.
+ *
+ * Segue as ligações das posições removidas e as comprime, apontando todas as posições visitadas
+ * para o resultado, de modo que chamadas seguintes não percorrem o mesmo caminho.
+ */
+std::size_t PackageStore::nextPresent(std::size_t index) {
+    uint64_t found = head_ + index;
+    while (found < tail_ && links_[slot(found)] != found) {
+        found = links_[slot(found)];
+    }
+    for (uint64_t sequence = head_ + index; sequence < found;) {
+        uint64_t next = links_[slot(sequence)];
+        links_[slot(sequence)] = found;
+        sequence = next;
+    }
+    return static_cast<std::size_t>(std::min(found, tail_) - head_);
+}
+
+/**
+ * @brief Número de posições da fila, incluindo pacotes removidos que ainda não chegaram ao
+ *        início.
+ */
+std::size_t PackageStore::size() const {
+    return static_cast<std::size_t>(tail_ - head_);
+}
+
+/**
+ * @brief Número de pacotes presentes, sem contar os removidos.
+ */
+std::size_t PackageStore::presentCount() const {
+    return present_;
+}
+
+/**
+ * @brief Indica se não há nenhum pacote presente. Como o primeiro nunca está removido, é o mesmo
+ *        que size() ser 0.
+ */
+bool PackageStore::empty() const {
+    return head_ == tail_;
+}
+
+int PackageStore::idAt(std::size_t index) const {
+    return ids_[slot(head_ + index)];
+}
+
+/**
+ * @brief Indica se o pacote no índice lógico `index` foi removido por erase().
+ */
+bool PackageStore::isRemoved(std::size_t index) const {
+    uint64_t sequence = head_ + index;
+    return links_[slot(sequence)] != sequence;
+}
+
+/**
+ * @brief Posição x atual do pacote no índice lógico `index`.
+ */
+float PackageStore::xAt(std::size_t index) const {
+    return startX_ + static_cast<float>(odometer_ - entries_[slot(head_ + index)]);
+}
+
+/**
+ * @brief Distância total percorrida pela esteira desde a sua criação.
+ */
+double PackageStore::getOdometer() const {
+    return odometer_;
+}
+
+/**
+ * @brief Valor do odômetro quando o pacote no índice lógico `index` entrou na esteira.
+ */
+double PackageStore::entryAt(std::size_t index) const {
+    return entries_[slot(head_ + index)];
+}
+
+/**
+ * @brief Sequência da primeira posição da fila.
+ */
+uint64_t PackageStore::getHead() const {
+    return head_;
+}
+
+/**
+ * @brief Sequência seguinte à última posição da fila, isto é, a do próximo push().
+ */
+uint64_t PackageStore::getTail() const {
+    return tail_;
+}
+
+/**
+ * @brief Número de posições do anel; size() nunca passa dele sem uma nova alocação.
+ */
+std::size_t PackageStore::capacity() const {
+    return ids_.size();
+}
+
+/**
+ * @brief Total de pacotes removidos do meio da fila por erase() desde a criação.
+ */
+uint64_t PackageStore::getRemovalCount() const {
+    return removals_;
+}
+
+/**
+ * @brief Sequência da posição marcada pela remoção número `removal` (contando de 0).
+ *
+ * @note Só as últimas REMOVAL_LOG_CAPACITY remoções ficam registradas: `removal` deve ser menor
+ *       que getRemovalCount() e no máximo REMOVAL_LOG_CAPACITY menor.
+ */
+uint64_t PackageStore::removedSequence(uint64_t removal) const {
+    return removalLog_[removal & (REMOVAL_LOG_CAPACITY - 1)];
+}
+
+/**
+ * @brief Posição física no anel da sequência `sequence`. A capacidade é potência de dois.
+ */
+std::size_t PackageStore::slot(uint64_t sequence) const {
+    return static_cast<std::size_t>(sequence & (ids_.size() - 1));
+}
+
+/**
+ * @brief Dobra a capacidade do anel, levando cada posição para o novo lugar da sua sequência.
+ */
+void PackageStore::grow() {
+    std::size_t capacity = ids_.empty() ? INITIAL_CAPACITY : ids_.size() * 2;
+    std::vector<int> ids(capacity);
+    std::vector<double> entries(capacity);
+    std::vector<uint64_t> links(capacity);
+    for (uint64_t sequence = head_; sequence < tail_; ++sequence) {
+        std::size_t to = static_cast<std::size_t>(sequence & (capacity - 1));
+        ids[to] = ids_[slot(sequence)];
+        entries[to] = entries_[slot(sequence)];
+        links[to] = links_[slot(sequence)];
+    }
+    ids_.swap(ids);
+    entries_.swap(entries);
+    links_.swap(links);
+}
+
+/**
+ * @brief Retira o primeiro pacote e as posições removidas que vêm logo depois dele, mantendo um
+ *        pacote presente no início.
+ */
+void PackageStore::popFront() {
+    ++head_;
+    --present_;
+    while (head_ != tail_ && links_[slot(head_)] != head_) {
+        ++head_;
+    }
+}
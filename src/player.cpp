@@ -1,85 +1,61 @@
-#include <iostream>
-
 #include <player.h>
 
-sf::Texture Player::texture_;
-
 /**
  * @brief Construtor da classe Player.
  *
- * Inicializa um objeto Player com as posições das pistas fornecidas.
- * Carrega a textura do jogador e configura a escala e a posição da forma do jogador.
+ * Inicializa o jogador no centro horizontal da tela, na faixa central.
  *
- * @param laneYs Vetor contendo as posições Y das pistas.
+ * @param laneCount Número de faixas disponíveis.
  */
-Player::Player(const std::vector<int> &laneYs) : laneYs_(laneYs), currentLane_(1) {
-    // shape_.setSize(sf::Vector2f(PLAYER_SIZE, PLAYER_SIZE));
-    // shape_.setFillColor(PLAYER_COLOR);
-    if (!Player::loadTexture()) {
-        std::cout << "Error loading player texture." << std::endl;
-    }
-    float scaleX = PLAYER_SIZE / texture_.getSize().x;
-    float scaleY = PLAYER_SIZE / texture_.getSize().y;
-    shape_.setScale(scaleX, scaleY);
-    shape_.setTexture(texture_);
-    shape_.setPosition(WIDTH / 2 - PLAYER_SIZE / 2,
-                       laneYs_[currentLane_] + THREADMILL_HEIGHT + PLAYER_OFFSET_Y);
-}
+Player::Player(int laneCount)
+    : x_(WIDTH / 2 - PLAYER_SIZE / 2), laneCount_(laneCount), currentLane_(laneCount / 2) {}
 
 /**
  * @brief Altera a faixa do jogador.
  *
  * Esta função altera a faixa do jogador com base na direção fornecida.
  * A nova faixa é calculada adicionando a direção à faixa atual. Se a nova
- * faixa estiver dentro dos limites permitidos (MIN_LANE e MAX_LANE), a faixa
- * atual do jogador é atualizada e a posição do jogador é ajustada
- * de acordo.
+ * faixa estiver dentro dos limites permitidos (MIN_LANE até laneCount - 1), a faixa
+ * atual do jogador é atualizada.
  *
  * @param direction A direção para a qual o jogador deve mudar de faixa.
- *                  Pode ser um valor positivo (para a direita) ou negativo
- *                  (para a esquerda).
+ *                  Pode ser um valor positivo (para baixo) ou negativo
+ *                  (para cima).
  */
 void Player::switchLane(int direction) {
     int newLane = currentLane_ + direction;
-    if (newLane >= MIN_LANE && newLane <= MAX_LANE) {
+    if (newLane >= MIN_LANE && newLane < laneCount_) {
         currentLane_ = newLane;
-        shape_.setPosition(shape_.getPosition().x,
-                           laneYs_[currentLane_] + THREADMILL_HEIGHT + PLAYER_OFFSET_Y);
     }
 }
 
 /**
- * @brief Manipula a entrada do jogador para mover o personagem.
+ * @brief Move o jogador horizontalmente.
  *
- * Esta função verifica se as teclas de movimento (A, D, Esquerda, Direita) estão pressionadas
- * e move o personagem na direção correspondente. O movimento é limitado pelas bordas da tela.
+ * Desloca o jogador na direção indicada (-1 para a esquerda, 1 para a direita) de acordo
+ * com PLAYER_SPEED. O movimento é limitado pelas bordas da tela.
  *
+ * @param direction A direção do movimento (-1, 0 ou 1).
  * @param deltaTime O tempo decorrido desde a última atualização, usado para calcular a distância de movimento.
  */
-void Player::handleInput(float deltaTime) {
+void Player::move(int direction, float deltaTime) {
     float movement = PLAYER_SPEED * deltaTime;
-    if (sf::Keyboard::isKeyPressed(sf::Keyboard::A) ||
-        sf::Keyboard::isKeyPressed(sf::Keyboard::Left)) {
-        if (shape_.getPosition().x - movement >= 0)
-            shape_.move(-movement, 0);
+    if (direction < 0) {
+        if (x_ - movement >= 0)
+            x_ -= movement;
     }
-    if (sf::Keyboard::isKeyPressed(sf::Keyboard::D) ||
-        sf::Keyboard::isKeyPressed(sf::Keyboard::Right)) {
-        if (shape_.getPosition().x + movement + PLAYER_SIZE <= WIDTH)
-            shape_.move(movement, 0);
+    if (direction > 0) {
+        if (x_ + movement + PLAYER_SIZE <= WIDTH)
+            x_ += movement;
     }
 }
 
-void Player::draw(sf::RenderWindow &window) {
-    window.draw(shape_);
-}
-
 float Player::getLeftX() const {
-    return shape_.getPosition().x;
+    return x_;
 }
 
 float Player::getRightX() const {
-    return shape_.getPosition().x + PLAYER_SIZE;
+    return x_ + PLAYER_SIZE;
 }
 
 /**
@@ -102,7 +78,3 @@ bool Player::canGrabPackage(const Package &package) const {
 int Player::getCurrentLane() const {
     return currentLane_;
 }
-
-bool Player::loadTexture() {
-    return texture_.loadFromFile(PLAYER_TEXTURE_PATH);
-}
\ No newline at end of file
@@ -0,0 +1,171 @@
+#include <iostream>
+
+#include <constants.h>
+#include <renderer.h>
+#include <stacking.h>
+#include <trace.h>
+
+Renderer::Renderer() : sceneVertices_(sf::Quads), shownScore_(INVALID), shownLives_(INVALID) {}
+
+/**
+ * @brief Carrega a fonte e as imagens usadas pelo jogo e monta o atlas.
+ *
+ * Pede todos os recursos ao ResourceCache de uma vez, para que sejam decodificados em paralelo,
+ * combina as imagens da esteira, do pacote e do operário em um TextureAtlas e guarda a região de
+ * cada uma. Configura os textos de pontuação, vidas e contagem de pacotes empilhados. Se ocorrer
+ * um erro durante o carregamento de qualquer um dos recursos, uma mensagem é exibida no console.
+ *
+ * @param resources Cache de onde os recursos são obtidos.
+ * @return true se todos os recursos foram carregados, false caso contrário.
+ */
+bool Renderer::loadAssets(ResourceCache &resources) {
+    resources.requestFont(FONT_PATH);
+    resources.requestImage(PACKAGE_TEXTURE_PATH);
+    resources.requestImage(PLAYER_TEXTURE_PATH);
+    resources.requestImage(THREADMILL_TEXTURE_PATH);
+    bool ok = resources.loadPending();
+
+    font_ = resources.getFont(FONT_PATH);
+    atlas_.add(PACKAGE_TEXTURE_PATH, resources.getImage(PACKAGE_TEXTURE_PATH));
+    atlas_.add(PLAYER_TEXTURE_PATH, resources.getImage(PLAYER_TEXTURE_PATH));
+    atlas_.add(THREADMILL_TEXTURE_PATH, resources.getImage(THREADMILL_TEXTURE_PATH));
+    if (!atlas_.build()) {
+        std::cout << "Error creating texture atlas." << std::endl;
+        ok = false;
+    }
+    packageRect_ = atlas_.getRect(PACKAGE_TEXTURE_PATH);
+    playerRect_ = atlas_.getRect(PLAYER_TEXTURE_PATH);
+    threadmillRect_ = atlas_.getRect(THREADMILL_TEXTURE_PATH);
+
+    textScore_.setFont(*font_);
+    textScore_.setCharacterSize(SCORE_TEXT_SIZE);
+    textScore_.setFillColor(sf::Color::White);
+    textScore_.setPosition(SCORE_TEXT_POS_X, SCORE_TEXT_POS_Y);
+
+    textLives_.setFont(*font_);
+    textLives_.setCharacterSize(SCORE_TEXT_SIZE);
+    textLives_.setFillColor(sf::Color::White);
+    textLives_.setPosition(LIVES_TEXT_POS_X, LIVES_TEXT_POS_Y);
+
+    countText_.setFont(*font_);
+    countText_.setCharacterSize(SCORE_TEXT_SIZE);
+    countText_.setFillColor(sf::Color::White);
+
+    return ok;
+}
+
+/**
+ * @brief Desenha um quadro na janela.
+ *
+ * Monta em um único lote a geometria de todas as esteiras, de todos os pacotes e do jogador, nessa
+ * ordem, e a envia em uma chamada de desenho com a textura do atlas. Em seguida desenha os
+ * números de pacotes empilhados, a pontuação e as vidas restantes.
+ * Não limpa nem exibe a janela; isso é responsabilidade de quem chama.
+ *
+ * @param window Janela onde os elementos serão desenhados.
+ * @param frame Estado do mundo a ser desenhado.
+ */
+void Renderer::draw(sf::RenderWindow &window, const FrameState &frame) {
+    TRACE_SCOPE("Renderer::draw");
+    sceneVertices_.clear();
+    stackLabels_.clear();
+
+    for (const LaneFrame &lane : frame.lanes) {
+        appendThreadmill(lane);
+    }
+    for (const LaneFrame &lane : frame.lanes) {
+        appendPackages(lane);
+    }
+    appendPlayer(frame);
+
+    window.draw(sceneVertices_, &atlas_.getTexture());
+
+    for (const StackLabel &label : stackLabels_) {
+        countText_.setString(std::to_string(label.count));
+        countText_.setPosition(label.x, label.y);
+        window.draw(countText_);
+    }
+
+    updateScoreText(frame.score);
+    updateLivesText(frame.lives);
+    window.draw(textScore_);
+    window.draw(textLives_);
+}
+
+/**
+ * @brief Acrescenta ao lote de desenho o quad da esteira.
+ */
+void Renderer::appendThreadmill(const LaneFrame &lane) {
+    appendQuad(0.0f, lane.y, THREADMILL_WIDTH, THREADMILL_HEIGHT, threadmillRect_);
+}
+
+/**
+ * @brief Acrescenta ao lote de desenho os pacotes da esteira e registra os números de
+ *        empilhamento.
+ *
+ * Quando múltiplos pacotes se sobrepõem, um número com a quantidade de pacotes do grupo é
+ * registrado para ser desenhado acima do pacote mais à frente. As pilhas são detectadas com
+ * forEachStack em uma única passada, sem ordenar nem alocar memória por quadro.
+ *
+ * @param lane Esteira cujos pacotes serão desenhados.
+ */
+void Renderer::appendPackages(const LaneFrame &lane) {
+    for (float x : lane.packageXs) {
+        appendQuad(x, lane.packageY, PACKAGE_SIZE, PACKAGE_SIZE, packageRect_);
+    }
+
+    forEachStack(lane.packageXs.data(), lane.packageXs.size(), [&](float topX, int count) {
+        float textX = topX + PACKAGE_SIZE / 2.0f;
+        float textY = lane.packageY - 20.0f;
+        stackLabels_.push_back({textX, textY, count});
+    });
+}
+
+/**
+ * @brief Acrescenta ao lote de desenho o operário, sobre a esteira da faixa atual do jogador.
+ */
+void Renderer::appendPlayer(const FrameState &frame) {
+    if (frame.playerLane < 0 || frame.playerLane >= static_cast<int>(frame.lanes.size()))
+        return;
+    const LaneFrame &lane = frame.lanes[static_cast<std::size_t>(frame.playerLane)];
+    appendQuad(frame.playerX, lane.y + THREADMILL_HEIGHT + PLAYER_OFFSET_Y, PLAYER_SIZE,
+               PLAYER_SIZE, playerRect_);
+}
+
+/**
+ * @brief Acrescenta ao lote de desenho um retângulo texturizado.
+ *
+ * A região `textureRect` do atlas é mapeada no retângulo `(x, y, width, height)`.
+ */
+void Renderer::appendQuad(float x, float y, float width, float height,
+                          const sf::IntRect &textureRect) {
+    float left = static_cast<float>(textureRect.left);
+    float top = static_cast<float>(textureRect.top);
+    float right = left + static_cast<float>(textureRect.width);
+    float bottom = top + static_cast<float>(textureRect.height);
+    sceneVertices_.append(sf::Vertex(sf::Vector2f(x, y), sf::Vector2f(left, top)));
+    sceneVertices_.append(sf::Vertex(sf::Vector2f(x + width, y), sf::Vector2f(right, top)));
+    sceneVertices_.append(
+        sf::Vertex(sf::Vector2f(x + width, y + height), sf::Vector2f(right, bottom)));
+    sceneVertices_.append(sf::Vertex(sf::Vector2f(x, y + height), sf::Vector2f(left, bottom)));
+}
+
+/**
+ * @brief Atualiza o texto da pontuação quando o valor muda.
+ */
+void Renderer::updateScoreText(int score) {
+    if (score == shownScore_)
+        return;
+    shownScore_ = score;
+    textScore_.setString("Score: " + std::to_string(score));
+}
+
+/**
+ * @brief Atualiza o texto de vidas quando o valor muda.
+ */
+void Renderer::updateLivesText(int lives) {
+    if (lives == shownLives_)
+        return;
+    shownLives_ = lives;
+    textLives_.setString("Vidas: " + std::to_string(lives));
+}
@@ -0,0 +1,198 @@
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+#include <resource_cache.h>
+#include <trace.h>
+#include <work_stealing_pool.h>
+
+/**
+ * @brief Pede o carregamento de uma imagem, sem textura, no próximo loadPending().
+ *
+ * @param path Caminho do arquivo de imagem; pedidos repetidos são ignorados.
+ */
+void ResourceCache::requestImage(const std::string &path) {
+    images_.try_emplace(path);
+}
+
+/**
+ * @brief Pede o carregamento de uma textura no próximo loadPending().
+ *
+ * @param path Caminho do arquivo de imagem; pedidos repetidos são ignorados.
+ */
+void ResourceCache::requestTexture(const std::string &path) {
+    textures_.try_emplace(path);
+}
+
+/**
+ * @brief Pede o carregamento de uma fonte no próximo loadPending().
+ *
+ * @param path Caminho do arquivo da fonte; pedidos repetidos são ignorados.
+ */
+void ResourceCache::requestFont(const std::string &path) {
+    fonts_.try_emplace(path);
+}
+
+/**
+ * @brief Passa a ler os recursos de arquivos em `directory` em vez da cópia embutida.
+ *
+ * O recurso `assets/caixa.png`, por exemplo, é lido de `<directory>/caixa.png`. Vale para os
+ * recursos carregados depois da chamada; um diretório vazio volta a usar a cópia embutida.
+ */
+void ResourceCache::setAssetDirectory(const std::string &directory) {
+    assetDirectory_ = directory;
+}
+
+/**
+ * @brief Carrega todos os recursos pedidos e ainda não carregados.
+ *
+ * Cada recurso é lido (da cópia embutida ou do arquivo) e decodificado por uma tarefa de um
+ * WorkStealingPool com uma thread por recurso, limitado ao número de núcleos. Depois que todas
+ * terminam, as imagens são enviadas para a GPU na thread que chamou, e a memória das imagens
+ * decodificadas é liberada. O tempo total é acumulado em getLoadSeconds(). Se algum recurso
+ * falhar, uma mensagem de erro é exibida no console.
+ *
+ * @return true se todos os recursos pendentes foram carregados, false caso contrário.
+ */
+bool ResourceCache::loadPending() {
+    TRACE_SCOPE("ResourceCache::loadPending");
+    auto start = std::chrono::steady_clock::now();
+
+    std::vector<std::pair<const std::string *, ImageEntry *>> images;
+    for (auto &[path, entry] : images_) {
+        if (entry.state == PENDING)
+            images.push_back({&path, &entry});
+    }
+    std::vector<std::pair<const std::string *, TextureEntry *>> textures;
+    for (auto &[path, entry] : textures_) {
+        if (entry.state == PENDING)
+            textures.push_back({&path, &entry});
+    }
+    std::vector<std::pair<const std::string *, FontEntry *>> fonts;
+    for (auto &[path, entry] : fonts_) {
+        if (entry.state == PENDING)
+            fonts.push_back({&path, &entry});
+    }
+    std::size_t pending = images.size() + textures.size() + fonts.size();
+    if (pending == 0)
+        return true;
+
+    {
+        unsigned cores = std::max(1u, std::thread::hardware_concurrency());
+        WorkStealingPool pool(static_cast<unsigned>(std::min<std::size_t>(pending, cores)));
+        auto decodeImage = [&pool, this](const std::string &path, sf::Image &image, State &state) {
+            pool.submit([embedded = embeddedAsset(path), file = filePath(path), &image, &state] {
+                TRACE_SCOPE("ResourceCache::decodeImage");
+                bool loaded = embedded ? image.loadFromMemory(embedded->data, embedded->size)
+                                       : image.loadFromFile(file);
+                state = loaded ? READY : FAILED;
+            });
+        };
+        for (auto [path, entry] : images) {
+            decodeImage(*path, *entry->image, entry->state);
+        }
+        for (auto [path, entry] : textures) {
+            decodeImage(*path, entry->image, entry->state);
+        }
+        for (auto [path, entry] : fonts) {
+            pool.submit([embedded = embeddedAsset(*path), file = filePath(*path), entry] {
+                TRACE_SCOPE("ResourceCache::decodeFont");
+                bool loaded = embedded ? entry->font->loadFromMemory(embedded->data, embedded->size)
+                                       : entry->font->loadFromFile(file);
+                entry->state = loaded ? READY : FAILED;
+            });
+        }
+        pool.wait();
+    }
+
+    bool ok = true;
+    for (auto [path, entry] : images) {
+        if (entry->state == FAILED) {
+            std::cout << "Error loading image " << *path << "." << std::endl;
+            ok = false;
+        }
+    }
+    for (auto [path, entry] : textures) {
+        if (entry->state == READY && !entry->texture->loadFromImage(entry->image))
+            entry->state = FAILED;
+        entry->image = sf::Image();
+        if (entry->state == FAILED) {
+            std::cout << "Error loading texture " << *path << "." << std::endl;
+            ok = false;
+        }
+    }
+    for (auto [path, entry] : fonts) {
+        if (entry->state == FAILED) {
+            std::cout << "Error loading font " << *path << "." << std::endl;
+            ok = false;
+        }
+    }
+
+    loadedCount_ += pending;
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    loadSeconds_ += elapsed.count();
+    return ok;
+}
+
+/**
+ * @brief Handle da imagem em `path`, carregando-a agora se ela não foi pedida antes.
+ */
+std::shared_ptr<const sf::Image> ResourceCache::getImage(const std::string &path) {
+    auto [entry, inserted] = images_.try_emplace(path);
+    if (inserted)
+        loadPending();
+    return entry->second.image;
+}
+
+/**
+ * @brief Handle da textura em `path`, carregando-a agora se ela não foi pedida antes.
+ */
+std::shared_ptr<const sf::Texture> ResourceCache::getTexture(const std::string &path) {
+    auto [entry, inserted] = textures_.try_emplace(path);
+    if (inserted)
+        loadPending();
+    return entry->second.texture;
+}
+
+/**
+ * @brief Handle da fonte em `path`, carregando-a agora se ela não foi pedida antes.
+ */
+std::shared_ptr<const sf::Font> ResourceCache::getFont(const std::string &path) {
+    auto [entry, inserted] = fonts_.try_emplace(path);
+    if (inserted)
+        loadPending();
+    return entry->second.font;
+}
+
+/**
+ * @brief Cópia embutida de `path`, ou nullptr se ela não existe ou foi substituída por arquivos.
+ */
+const EmbeddedAsset *ResourceCache::embeddedAsset(const std::string &path) const {
+    return assetDirectory_.empty() ? findEmbeddedAsset(path) : nullptr;
+}
+
+/**
+ * @brief Caminho do arquivo de onde `path` é lido quando não há cópia embutida.
+ */
+std::string ResourceCache::filePath(const std::string &path) const {
+    if (assetDirectory_.empty())
+        return path;
+    std::size_t slash = path.find_last_of('/');
+    return assetDirectory_ + "/" + (slash == std::string::npos ? path : path.substr(slash + 1));
+}
+
+/**
+ * @brief Número de arquivos distintos já processados por loadPending().
+ */
+std::size_t ResourceCache::getLoadedCount() const {
+    return loadedCount_;
+}
+
+/**
+ * @brief Tempo total gasto em loadPending(), em segundos.
+ */
+double ResourceCache::getLoadSeconds() const {
+    return loadSeconds_;
+}
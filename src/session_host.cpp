@@ -0,0 +1,110 @@
+#include <algorithm>
+#include <chrono>
+
+#include <session_host.h>
+#include <trace.h>
+
+namespace {
+// Chance, a cada passo, de o jogador aleatório trocar de faixa, tentar coletar e mudar de direção.
+constexpr unsigned SWITCH_ONE_IN = 30;
+constexpr unsigned COLLECT_ONE_IN = 8;
+constexpr unsigned TURN_ONE_IN = 60;
+// Lotes por thread do pool, para que o roubo de tarefas equilibre partidas mais lentas.
+constexpr int BATCHES_PER_THREAD = 8;
+// Pacotes reservados por esteira. Uma partida raramente passa de algumas dezenas de pacotes
+// por esteira, e com milhares de partidas a reserva padrão do jogo custaria dezenas de KiB cada.
+constexpr std::size_t SESSION_PACKAGE_RESERVE = 16;
+} // namespace
+
+SessionHost::Session::Session(const WorldConfig &config)
+    : world(config), rng(config.seed), direction(0) {}
+
+/**
+ * @brief Construtor da classe SessionHost.
+ *
+ * Cria o pool compartilhado e todas as partidas, cada uma com a sua semente. Uma semente
+ * derivada que dê a volta e resulte em 0 é trocada por 1, já que 0 faria o SimulationWorld
+ * sortear uma semente e a partida deixaria de ser reproduzível.
+ *
+ * @param config Parâmetros do host.
+ */
+SessionHost::SessionHost(const HostConfig &config)
+    : config_(config), pool_(config.workerThreads > 0 ? config.workerThreads
+                                                      : std::thread::hardware_concurrency()) {
+    WorldConfig world;
+    world.threadedLanes = false;
+    world.packageReserve = SESSION_PACKAGE_RESERVE;
+    sessions_.reserve(static_cast<std::size_t>(std::max(0, config_.sessions)));
+    for (int i = 0; i < config_.sessions; ++i) {
+        uint32_t derived = config_.seed + static_cast<uint32_t>(i);
+        world.seed = derived == 0 ? 1 : derived;
+        sessions_.push_back(std::make_unique<Session>(world));
+    }
+}
+
+/**
+ * @brief Avança todas as partidas `config.ticks` passos e mede o tempo total.
+ *
+ * Chamadas repetidas continuam as partidas de onde pararam.
+ *
+ * @return Passos executados, somados entre as partidas, tempo gasto e pontuação somada.
+ */
+HostResult SessionHost::run() {
+    TRACE_SCOPE("SessionHost::run");
+    int count = static_cast<int>(sessions_.size());
+    int batches = std::max(1, static_cast<int>(pool_.size()) * BATCHES_PER_THREAD);
+    int batchSize = std::max(1, (count + batches - 1) / batches);
+    uint32_t ticks = config_.ticks;
+
+    auto start = std::chrono::steady_clock::now();
+    for (int first = 0; first < count; first += batchSize) {
+        int last = std::min(count, first + batchSize);
+        pool_.submit([this, first, last, ticks] {
+            TRACE_SCOPE("SessionHost::batch");
+            for (int i = first; i < last; ++i) {
+                Session &session = *sessions_[i];
+                float step = session.world.getClock().getStep();
+                for (uint32_t tick = 0; tick < ticks; ++tick) {
+                    stepSession(session, step);
+                }
+            }
+        });
+    }
+    pool_.wait();
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+    int64_t totalScore = 0;
+    int bestScore = 0;
+    for (const auto &session : sessions_) {
+        totalScore += session->world.getScore();
+        bestScore = std::max(bestScore, session->world.getScore());
+    }
+    return {count, pool_.size(), static_cast<uint64_t>(count) * ticks, elapsed.count(),
+            totalScore, bestScore};
+}
+
+/**
+ * @brief Executa um passo fixo de uma partida, com as ações do Autoplayer ou do jogador
+ *        aleatório.
+ *
+ * Faz o mesmo que um passo de replayRecording: ações, movimento e update().
+ */
+void SessionHost::stepSession(Session &session, float step) const {
+    if (config_.autoplay) {
+        AutoplayerAction action = session.autoplayer.decide(session.world);
+        if (action.laneDirection != 0)
+            session.world.switchLane(action.laneDirection);
+        if (action.collect)
+            session.world.collectPackage();
+        session.direction = action.direction;
+    } else {
+        if (session.rng() % SWITCH_ONE_IN == 0)
+            session.world.switchLane(session.rng() % 2 == 0 ? -1 : 1);
+        if (session.rng() % COLLECT_ONE_IN == 0)
+            session.world.collectPackage();
+        if (session.rng() % TURN_ONE_IN == 0)
+            session.direction = static_cast<int>(session.rng() % 3) - 1;
+    }
+    session.world.movePlayer(session.direction, step);
+    session.world.update(step);
+}
@@ -0,0 +1,100 @@
+#include <thread>
+
+#include <simulation_clock.h>
+
+/**
+ * @brief Construtor da classe SimulationClock.
+ *
+ * O relógio é iniciado imediatamente; start() pode ser chamada para reposicionar o instante inicial.
+ *
+ * @param stepSeconds Duração de cada passo, em segundos.
+ * @param maxCatchUpSteps Máximo de passos executados de uma vez por um consumidor atrasado.
+ */
+SimulationClock::SimulationClock(float stepSeconds, int maxCatchUpSteps)
+    : stepDuration_(std::chrono::duration_cast<Clock::duration>(
+          std::chrono::duration<float>(stepSeconds))),
+      stepSeconds_(stepSeconds), maxCatchUpSteps_(maxCatchUpSteps), epoch_(Clock::now()),
+      overruns_(0), droppedSteps_(0) {}
+
+/**
+ * @brief Define o instante atual como início da grade de passos.
+ *
+ * @note Deve ser chamada antes de os consumidores começarem a usar o relógio.
+ */
+void SimulationClock::start() {
+    epoch_ = Clock::now();
+}
+
+/**
+ * @brief Retorna quantos passos o consumidor deve executar agora.
+ *
+ * Compara o índice do último passo executado com o número de passos decorridos desde o início
+ * e avança `tick` até o passo atual. Se mais de um passo venceu, o consumidor atrasou e um
+ * estouro é contabilizado; passos além de `maxCatchUpSteps` são descartados e contabilizados.
+ *
+ * @param tick Índice do último passo executado pelo consumidor; é atualizado.
+ * @return O número de passos de duração getStep() a executar.
+ */
+int SimulationClock::stepsDue(uint64_t &tick) {
+    uint64_t elapsed = static_cast<uint64_t>((Clock::now() - epoch_) / stepDuration_);
+    if (elapsed <= tick)
+        return 0;
+
+    uint64_t due = elapsed - tick;
+    tick = elapsed;
+    if (due > 1) {
+        overruns_.fetch_add(1, std::memory_order_relaxed);
+    }
+    if (due > static_cast<uint64_t>(maxCatchUpSteps_)) {
+        droppedSteps_.fetch_add(due - maxCatchUpSteps_, std::memory_order_relaxed);
+        due = maxCatchUpSteps_;
+    }
+    return static_cast<int>(due);
+}
+
+/**
+ * @brief Posiciona `tick` no passo atual sem executar nem contabilizar os passos intermediários.
+ *
+ * Usada por um consumidor que esteve parado de propósito (por exemplo, sem esteiras ativas) e
+ * não deve recuperar o tempo em que ficou parado.
+ *
+ * @param tick Índice do último passo executado pelo consumidor; é atualizado.
+ */
+void SimulationClock::resync(uint64_t &tick) const {
+    uint64_t elapsed = static_cast<uint64_t>((Clock::now() - epoch_) / stepDuration_);
+    if (elapsed > tick)
+        tick = elapsed;
+}
+
+/**
+ * @brief Prazo absoluto do passo seguinte a `tick`.
+ *
+ * @param tick Índice do último passo executado.
+ */
+SimulationClock::Clock::time_point SimulationClock::stepDeadline(uint64_t tick) const {
+    return epoch_ + stepDuration_ * static_cast<int64_t>(tick + 1);
+}
+
+/**
+ * @brief Dorme até o prazo do passo seguinte a `tick`.
+ *
+ * O prazo é absoluto (sleep_until), calculado a partir do instante inicial, de modo que o tempo
+ * gasto no passo atual não desloca os passos seguintes.
+ *
+ * @param tick Índice do último passo executado.
+ */
+void SimulationClock::sleepUntilStep(uint64_t tick) const {
+    std::this_thread::sleep_until(stepDeadline(tick));
+}
+
+float SimulationClock::getStep() const {
+    return stepSeconds_;
+}
+
+uint64_t SimulationClock::getOverruns() const {
+    return overruns_.load(std::memory_order_relaxed);
+}
+
+uint64_t SimulationClock::getDroppedSteps() const {
+    return droppedSteps_.load(std::memory_order_relaxed);
+}
@@ -0,0 +1,386 @@
+#include <simulation_world.h>
+#include <trace.h>
+
+/**
+ * @brief Construtor da classe SimulationWorld.
+ *
+ * Cria `config.laneCount` esteiras espaçadas verticalmente, o jogador, o gerador de números
+ * aleatórios (com `config.seed`, ou uma semente sorteada se ela for 0) e o estado de pontuação, vidas e geração de pacotes. Adiciona um pacote inicial à
+ * esteira central e ativa a esteira da faixa do jogador. No modo com threads, cria o pool de
+ * trabalhadores; a thread que agenda os passos das esteiras só é criada por start().
+ *
+ * @param config Parâmetros do mundo.
+ */
+SimulationWorld::SimulationWorld(const WorldConfig &config)
+    : config_(config), score_(SCORE_INITIAL), lives_(MAX_LIVES), player_(config.laneCount),
+      rng_(config.seed), distLane_(0, config.laneCount - 1), spawnElapsed_(0.0f),
+      currentSpawnInterval_(PACKAGE_SPAWN_INTERVAL_BASE), spawnIntervalSteps_(0), nextId_(1),
+      started_(false), stopLanes_(false), activationEpoch_(0) {
+    if (config_.seed == 0) {
+        config_.seed = std::random_device{}();
+        rng_.seed(config_.seed);
+    }
+
+    for (int lane = 0; lane < config_.laneCount; ++lane) {
+        int y = THREADMILL_Y_POS_TOP + lane * THREADMILL_LANE_SPACING;
+        lanes_.push_back(
+            std::make_unique<Threadmill>(y, PACKAGE_SPEED_BASE, config_.packageReserve));
+    }
+
+    lanes_[config_.laneCount / 2]->addPackage(nextId_++);
+
+    updateActiveThreadmills();
+
+    if (config_.threadedLanes) {
+        pool_ = config_.workerThreads > 0 ? std::make_unique<WorkStealingPool>(config_.workerThreads)
+                                          : std::make_unique<WorkStealingPool>();
+    }
+}
+
+/**
+ * @brief Começa a contar o tempo da simulação.
+ *
+ * Reinicia o SimulationClock no instante atual e, no modo com threads, cria a thread que agenda
+ * os passos das esteiras, que até então ficam paradas. Deve ser chamada uma vez, logo antes do
+ * primeiro update(); chamadas seguintes são ignoradas.
+ */
+void SimulationWorld::start() {
+    if (started_)
+        return;
+    started_ = true;
+    clock_.start();
+    if (config_.threadedLanes) {
+        laneThread_ = std::thread(&SimulationWorld::runLanes, this);
+    }
+}
+
+/**
+ * @brief Destrutor da classe SimulationWorld.
+ *
+ * Sinaliza a parada da thread que agenda as esteiras, acordando-a caso esteja esperando uma
+ * ativação, e espera que ela termine antes de destruir o pool e as esteiras.
+ */
+SimulationWorld::~SimulationWorld() {
+    stopLanes_ = true;
+    activationEpoch_.fetch_add(1, std::memory_order_release);
+    activationEpoch_.notify_all();
+    if (laneThread_.joinable()) {
+        laneThread_.join();
+    }
+}
+
+/**
+ * @brief Atualiza o estado do mundo.
+ *
+ * No modo sem threads, avança a esteira ativa em `deltaTime` e aplica os comandos pendentes
+ * das demais.
+ * Em seguida consome os eventos de cada esteira, repassando-os ao ouvinte, se houver, e
+ * contabiliza os pacotes perdidos, atualiza o número de vidas, reinicia o jogo
+ * se necessário e gera novos pacotes em intervalos regulares.
+ *
+ * @param deltaTime O tempo decorrido desde a última atualização, em segundos.
+ */
+void SimulationWorld::update(float deltaTime) {
+    if (!config_.threadedLanes) {
+        for (auto &lane : lanes_) {
+            if (lane->isActive()) {
+                lane->step(deltaTime);
+            } else if (lane->hasPendingCommands()) {
+                lane->applyCommands();
+            }
+        }
+    }
+
+    int totalLostPackages = 0;
+    for (int lane = 0; lane < config_.laneCount; ++lane) {
+        lanes_[lane]->drainEvents([this, lane, &totalLostPackages](const LaneEvent &event) {
+            if (event.type == LaneEvent::EXPIRED)
+                totalLostPackages += event.count;
+            if (laneEventListener_)
+                laneEventListener_(lane, event);
+        });
+    }
+
+    if (totalLostPackages > 0) {
+        lives_ -= totalLostPackages;
+        if (lives_ < 0)
+            lives_ = 0;
+
+        if (lives_ <= 0) {
+            resetGame();
+        }
+    }
+
+    spawnElapsed_ += deltaTime;
+    if (spawnElapsed_ >= currentSpawnInterval_) {
+        spawnRandomPackage();
+        spawnElapsed_ = 0.0f;
+    }
+}
+
+/**
+ * @brief Coleta pacotes da esteira atual.
+ *
+ * Esta função coleta pacotes da esteira na mesma faixa que o jogador está atualmente.
+ * Threadmill::tryCollect encontra o primeiro pacote ao alcance do jogador (o critério de
+ * Player::canGrabPackage) e o remove em uma única operação sobre os pacotes da própria esteira,
+ * de modo que a esteira não pode perder o mesmo pacote entre a busca e a remoção.
+ * Se um pacote foi coletado, a pontuação é incrementada e a velocidade dos pacotes e o
+ * intervalo de spawn são atualizados.
+ *
+ * @return true se um pacote foi coletado.
+ */
+bool SimulationWorld::collectPackage() {
+    int currentLane = player_.getCurrentLane();
+    Threadmill *currentThreadmill = getThreadmillByLane(currentLane);
+    if (!currentThreadmill ||
+        !currentThreadmill->tryCollect(player_.getLeftX(), player_.getRightX()))
+        return false;
+
+    score_++;
+    updatePackageSpeed();
+    updatePackageSpawnInterval();
+    return true;
+}
+
+/**
+ * @brief Registra uma função chamada por update() para cada LaneEvent de cada esteira.
+ *
+ * @param listener Recebe o índice da esteira e o evento; vazio para remover o ouvinte.
+ */
+void SimulationWorld::setLaneEventListener(LaneEventListener listener) {
+    laneEventListener_ = std::move(listener);
+}
+
+/**
+ * @brief Troca o jogador de faixa e ativa a esteira correspondente.
+ *
+ * @param direction -1 para a faixa acima, 1 para a faixa abaixo.
+ */
+void SimulationWorld::switchLane(int direction) {
+    player_.switchLane(direction);
+    updateActiveThreadmills();
+}
+
+/**
+ * @brief Move o jogador horizontalmente.
+ *
+ * @param direction -1 para a esquerda, 1 para a direita, 0 para nenhum movimento.
+ * @param deltaTime O tempo decorrido desde a última atualização, em segundos.
+ */
+void SimulationWorld::movePlayer(int direction, float deltaTime) {
+    player_.move(direction, deltaTime);
+}
+
+/**
+ * @brief Gera um pacote aleatório e o adiciona a uma das esteiras.
+ *
+ * Esta função sorteia uma esteira com o gerador do mundo, semeado por WorldConfig::seed, e
+ * adiciona um novo pacote a ela.
+ * O pacote recebe um identificador único que é incrementado a cada novo pacote.
+ */
+void SimulationWorld::spawnRandomPackage() {
+    lanes_[distLane_(rng_)]->addPackage(nextId_++);
+}
+
+/**
+ * @brief Atualiza a velocidade dos pacotes na esteira.
+ *
+ * A velocidade dos pacotes é calculada com base em uma velocidade base,
+ * incrementada por um valor que depende da pontuação atual do jogo.
+ * A nova velocidade é então aplicada a todas as esteiras.
+ */
+void SimulationWorld::updatePackageSpeed() {
+    float newSpeed =
+        PACKAGE_SPEED_BASE + (static_cast<int>(score_ / SCORE_THRESHOLD) * PACKAGE_SPEED_INCREMENT);
+    for (auto &lane : lanes_) {
+        lane->setPackageSpeed(newSpeed);
+    }
+}
+
+/**
+ * @brief Atualiza o intervalo de spawn dos pacotes com base na pontuação atual.
+ *
+ * Esta função ajusta o intervalo de spawn dos pacotes conforme a pontuação do jogo aumenta.
+ * A cada vez que a pontuação atinge um múltiplo do SCORE_THRESHOLD, o intervalo de spawn
+ * é decrementado por PACKAGE_SPAWN_INTERVAL_DECREMENT, até um valor mínimo definido por
+ * PACKAGE_SPAWN_INTERVAL_MIN.
+ */
+void SimulationWorld::updatePackageSpawnInterval() {
+    while (score_ >= (spawnIntervalSteps_ + 1) * SCORE_THRESHOLD) {
+        currentSpawnInterval_ -= PACKAGE_SPAWN_INTERVAL_DECREMENT;
+        if (currentSpawnInterval_ < PACKAGE_SPAWN_INTERVAL_MIN) {
+            currentSpawnInterval_ = PACKAGE_SPAWN_INTERVAL_MIN;
+        }
+        spawnIntervalSteps_++;
+    }
+}
+
+/**
+ * @brief Reinicia o estado do jogo para os valores iniciais.
+ *
+ * Esta função redefine a pontuação, vidas e intervalos de spawn para os valores iniciais.
+ * Além disso, limpa todos os pacotes das esteiras e adiciona um novo pacote na esteira central.
+ */
+void SimulationWorld::resetGame() {
+    score_ = SCORE_INITIAL;
+    lives_ = MAX_LIVES;
+
+    updatePackageSpeed();
+
+    currentSpawnInterval_ = PACKAGE_SPAWN_INTERVAL_BASE;
+    spawnIntervalSteps_ = 0;
+
+    for (auto &lane : lanes_) {
+        lane->clearPackages();
+    }
+
+    lanes_[config_.laneCount / 2]->addPackage(nextId_++);
+}
+
+int SimulationWorld::getScore() const {
+    return score_;
+}
+
+int SimulationWorld::getLives() const {
+    return lives_;
+}
+
+int SimulationWorld::getLaneCount() const {
+    return config_.laneCount;
+}
+
+/**
+ * @brief Semente efetivamente usada pelo gerador de números aleatórios.
+ */
+uint32_t SimulationWorld::getSeed() const {
+    return config_.seed;
+}
+
+const Player &SimulationWorld::getPlayer() const {
+    return player_;
+}
+
+SimulationClock &SimulationWorld::getClock() {
+    return clock_;
+}
+
+/**
+ * @brief Soma em `out` as latências de troca de faixa medidas por todas as esteiras.
+ *
+ * Cada amostra é o tempo entre a ativação de uma esteira e o primeiro passo que ela executou.
+ */
+void SimulationWorld::collectLaneSwitchLatency(LatencyHistogram &out) const {
+    for (const auto &lane : lanes_) {
+        out.merge(lane->getActivationLatency());
+    }
+}
+
+/**
+ * @brief Total de LaneEvent descartados por anéis de eventos cheios, somando todas as esteiras.
+ *
+ * Expirações descartadas continuam descontando vidas e chegam ao ouvinte de
+ * setLaneEventListener() resumidas em um único evento; entradas e coletas descartadas não
+ * chegam, de modo que contagens feitas pelo ouvinte ficam abaixo do real.
+ */
+uint64_t SimulationWorld::getDroppedLaneEvents() const {
+    uint64_t dropped = 0;
+    for (const auto &lane : lanes_) {
+        dropped += lane->getDroppedEvents();
+    }
+    return dropped;
+}
+
+/**
+ * @brief Retorna a esteira correspondente à faixa especificada.
+ *
+ * As faixas são numeradas de cima para baixo, a partir de 0.
+ *
+ * @param lane O número da faixa.
+ * @return Um ponteiro para a esteira correspondente à faixa especificada,
+ *         ou nullptr se a faixa for inválida.
+ */
+Threadmill *SimulationWorld::getThreadmillByLane(int lane) {
+    if (lane < 0 || lane >= config_.laneCount)
+        return nullptr;
+    return lanes_[lane].get();
+}
+
+/**
+ * @brief Atualiza as esteiras ativas.
+ *
+ * Esta função desativa as demais esteiras e ativa apenas a esteira correspondente à faixa
+ * atual do jogador. A desativação vale imediatamente (veja Threadmill::deactivate); uma
+ * ativação acorda a thread de controle caso ela esteja esperando por esteiras ativas.
+ */
+void SimulationWorld::updateActiveThreadmills() {
+    int currentLane = player_.getCurrentLane();
+    for (int lane = 0; lane < config_.laneCount; ++lane) {
+        if (lane != currentLane) {
+            lanes_[lane]->deactivate();
+        }
+    }
+
+    Threadmill *currentThreadmill = getThreadmillByLane(currentLane);
+    if (currentThreadmill && currentThreadmill->activate()) {
+        activationEpoch_.fetch_add(1, std::memory_order_release);
+        activationEpoch_.notify_one();
+    }
+}
+
+/**
+ * @brief Indica se alguma esteira está ativa.
+ */
+bool SimulationWorld::anyLaneActive() const {
+    for (const auto &lane : lanes_) {
+        if (lane->isActive())
+            return true;
+    }
+    return false;
+}
+
+/**
+ * @brief Laço da thread que agenda as esteiras no modo com threads.
+ *
+ * A cada iteração pergunta ao SimulationClock quantos passos fixos venceram, submete ao pool
+ * uma tarefa por esteira ativa que executa esses passos (e uma por esteira inativa com comandos
+ * pendentes, que apenas os aplica), espera todas terminarem e dorme até o prazo absoluto do
+ * próximo passo. Assim o deslocamento dos pacotes depende apenas do tempo decorrido, e não da
+ * carga da máquina.
+ *
+ * Sem esteiras ativas, a thread espera em `activationEpoch_` até a próxima ativação e então
+ * retoma a grade de passos a partir do instante atual, sem recuperar o tempo parado.
+ */
+void SimulationWorld::runLanes() {
+    TRACE_THREAD_NAME("lanes");
+    uint64_t tick = 0;
+    float step = clock_.getStep();
+    while (!stopLanes_) {
+        uint32_t epoch = activationEpoch_.load(std::memory_order_acquire);
+        if (!anyLaneActive()) {
+            activationEpoch_.wait(epoch, std::memory_order_acquire);
+            clock_.resync(tick);
+            continue;
+        }
+
+        int steps = clock_.stepsDue(tick);
+        if (steps > 0) {
+            TRACE_SCOPE("SimulationWorld::runLanes tick");
+            for (auto &lane : lanes_) {
+                Threadmill *threadmill = lane.get();
+                if (threadmill->isActive()) {
+                    pool_->submit([threadmill, steps, step] {
+                        for (int i = 0; i < steps; ++i) {
+                            threadmill->step(step);
+                        }
+                    });
+                } else if (threadmill->hasPendingCommands()) {
+                    pool_->submit([threadmill] { threadmill->applyCommands(); });
+                }
+            }
+            pool_->wait();
+        }
+
+        clock_.sleepUntilStep(tick);
+    }
+}
@@ -0,0 +1,83 @@
+#include <algorithm>
+
+#include <texture_atlas.h>
+#include <trace.h>
+
+namespace {
+constexpr unsigned PADDING = 1;
+}
+
+/**
+ * @brief Registra uma imagem para o próximo build().
+ *
+ * @param name Nome usado em getRect(), normalmente o caminho do arquivo.
+ * @param image Imagem decodificada; o atlas a mantém apenas até build().
+ */
+void TextureAtlas::add(const std::string &name, std::shared_ptr<const sf::Image> image) {
+    regions_.push_back({name, std::move(image), sf::IntRect()});
+}
+
+/**
+ * @brief Empacota as imagens registradas e cria a textura do atlas.
+ *
+ * @return false se a textura não pôde ser criada.
+ */
+bool TextureAtlas::build() {
+    TRACE_SCOPE("TextureAtlas::build");
+    std::vector<Region *> order;
+    unsigned widest = 1;
+    std::size_t area = 0;
+    for (Region &region : regions_) {
+        sf::Vector2u size = region.image->getSize();
+        widest = std::max(widest, size.x + PADDING);
+        area += static_cast<std::size_t>(size.x + PADDING) * (size.y + PADDING);
+        order.push_back(&region);
+    }
+    unsigned width = 1;
+    while (width < widest || static_cast<std::size_t>(width) * width < area) {
+        width *= 2;
+    }
+
+    std::sort(order.begin(), order.end(), [](const Region *a, const Region *b) {
+        return a->image->getSize().y > b->image->getSize().y;
+    });
+    unsigned x = 0;
+    unsigned y = 0;
+    unsigned shelfHeight = 0;
+    for (Region *region : order) {
+        sf::Vector2u size = region->image->getSize();
+        if (x + size.x > width) {
+            x = 0;
+            y += shelfHeight;
+            shelfHeight = 0;
+        }
+        region->rect = sf::IntRect(static_cast<int>(x), static_cast<int>(y),
+                                   static_cast<int>(size.x), static_cast<int>(size.y));
+        x += size.x + PADDING;
+        shelfHeight = std::max(shelfHeight, size.y + PADDING);
+    }
+
+    sf::Image atlas;
+    atlas.create(width, std::max(1u, y + shelfHeight), sf::Color::Transparent);
+    for (Region &region : regions_) {
+        atlas.copy(*region.image, static_cast<unsigned>(region.rect.left),
+                   static_cast<unsigned>(region.rect.top));
+        region.image.reset();
+    }
+    return texture_.loadFromImage(atlas);
+}
+
+/**
+ * @brief Região da imagem `name` dentro da textura, ou um retângulo vazio se ela não existe.
+ */
+sf::IntRect TextureAtlas::getRect(const std::string &name) const {
+    for (const Region &region : regions_) {
+        if (region.name == name)
+            return region.rect;
+    }
+    return sf::IntRect();
+}
+
+const sf::Texture &TextureAtlas::getTexture() const {
+    return texture_;
+}
@@ -1,311 +1,439 @@
-#include <iostream>
+#include <algorithm>
+#include <chrono>
+#include <thread>
 
 #include <threadmill.h>
+#include <trace.h>
 
-sf::Texture Threadmill::threadmillTexture_;
-bool Threadmill::loaded = false;
+namespace {
+/// Instante atual em nanossegundos de std::chrono::steady_clock, o relógio de LaneEvent::time.
+int64_t nowNanoseconds() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+} // namespace
 
 /**
  * @brief Construtor da classe Threadmill.
  *
  * Inicializa uma instância da esteira com a posição vertical e a velocidade do pacote especificadas.
- * Configura a textura e a escala da esteira, e inicia a thread de execução.
+ * A esteira começa desativada. A memória para packageReserve pacotes é reservada no
+ * armazenamento e nos três snapshots, de modo que até esse número de pacotes a esteira não
+ * aloca memória depois de construída.
  *
  * @param y Posição vertical da esteira.
  * @param packageSpeed Velocidade do pacote na esteira.
+ * @param packageReserve Número de pacotes reservados de antemão.
  */
-Threadmill::Threadmill(int y, float packageSpeed)
-    : y_(y), packageSpeed_(packageSpeed), semaphore_(0), isActive_(false), stop_(false),
-      lostPackages_(0) {
-    // threadmillShape_.setSize(sf::Vector2f(THREADMILL_WIDTH, THREADMILL_HEIGHT));
-    // threadmillShape_.setFillColor(THREADMILL_COLOR);
-    if (!loaded) {
-        if (!loadTexture()) {
-            std::cout << "Failed to load threadmill texture" << std::endl;
-        } else {
-            loaded = true;
-        }
-    }
-    float scaleX = static_cast<float>(THREADMILL_WIDTH) / threadmillTexture_.getSize().x;
-    float scaleY = static_cast<float>(THREADMILL_HEIGHT) / threadmillTexture_.getSize().y;
-    threadmillShape_.setScale(scaleX, scaleY);
-    threadmillShape_.setTexture(threadmillTexture_);
-    threadmillShape_.setPosition(0.0f, y_);
-
-    thread_ = std::thread(&Threadmill::run, this);
-}
-
-/**
- * @brief Destrutor da classe Threadmill.
- *
- * Este destrutor garante que a thread associada à instância de Threadmill
- * seja corretamente finalizada. Ele faz isso definindo a flag `stop_` como
- * verdadeira e `isActive_` como falsa dentro de um bloco protegido por um
- * mutex. Em seguida, libera o semáforo e, se a thread estiver em um estado
- * "joinable", chama `join` para esperar que a thread termine sua execução.
- */
-Threadmill::~Threadmill() {
-    {
-        std::lock_guard<std::mutex> lock(mtx_);
-        stop_ = true;
-        isActive_ = false;
-    }
-    semaphore_.release();
-    if (thread_.joinable()) {
-        thread_.join();
-    }
+Threadmill::Threadmill(int y, float packageSpeed, std::size_t packageReserve)
+    : packages_(PACKAGE_START_X, packageSpeed), y_(y), snapshotEpoch_(0),
+      isActive_(false), activatedAt_(0), overflowExpired_(0), droppedEvents_(0) {
+    packages_.reserve(packageReserve);
+    snapshots_.forEachBuffer([this](LaneSnapshot &snapshot) {
+        snapshot.ids.resize(packages_.capacity());
+        snapshot.entries.resize(packages_.capacity());
+    });
 }
 
 /**
  * @brief Adiciona um pacote à esteira.
  * 
- * Esta função adiciona um novo pacote à lista de pacotes da esteira. 
+ * Esta função agenda a entrada de um novo pacote na esteira. 
  * O pacote é identificado por um ID único e é posicionado na coordenada 
- * inicial da esteira com uma velocidade predefinida.
+ * inicial da esteira quando o comando for aplicado.
  * 
  * @param id Identificador único do pacote.
  */
 void Threadmill::addPackage(int id) {
-    std::lock_guard<std::mutex> lock(mtx_);
-    float startY = y_ + (THREADMILL_HEIGHT - PACKAGE_SIZE) / 2.0f;
-    packages_.emplace(id, Package(id, PACKAGE_START_X, startY, packageSpeed_));
+    LaneCommand command;
+    command.type = LaneCommand::ADD;
+    command.id = id;
+    enqueue(command);
+}
+
+/**
+ * @brief Adiciona vários pacotes à esteira com um único comando.
+ *
+ * @param firstId Identificador do primeiro pacote; os demais recebem os ids seguintes.
+ * @param count Número de pacotes.
+ */
+void Threadmill::addPackages(int firstId, int count) {
+    if (count <= 0)
+        return;
+    LaneCommand command;
+    command.type = LaneCommand::ADD_BATCH;
+    command.id = firstId;
+    command.count = count;
+    enqueue(command);
 }
 
 /**
  * @brief Remove um pacote da lista de pacotes.
  * 
- * Esta função remove um pacote identificado pelo seu ID da lista de pacotes.
- * A operação é protegida por um mutex para garantir a segurança em ambientes
- * multithread.
+ * Esta função agenda a remoção do pacote identificado pelo seu ID. Para coletar o pacote ao
+ * alcance do jogador, use tryCollect(), que encontra e remove o pacote em uma única operação.
  * 
  * @param id O identificador do pacote a ser removido.
  */
 void Threadmill::removePackage(int id) {
-    std::lock_guard<std::mutex> lock(mtx_);
-    packages_.erase(id);
+    LaneCommand command;
+    command.type = LaneCommand::REMOVE;
+    command.id = id;
+    enqueue(command);
 }
 
 /**
  * @brief Define a nova velocidade dos pacotes na esteira.
  * 
- * Esta função define a velocidade dos pacotes na esteira para um novo valor especificado.
- * A função é thread-safe, utilizando um mutex para garantir que a operação seja atômica.
+ * Esta função agenda a troca da velocidade dos pacotes na esteira para um novo valor
+ * especificado. Como a velocidade é da esteira, e não de cada pacote, aplicar o comando custa
+ * O(1).
  * 
  * @param newSpeed A nova velocidade a ser definida para os pacotes.
  */
 void Threadmill::setPackageSpeed(float newSpeed) {
-    std::lock_guard<std::mutex> lock(mtx_);
-    packageSpeed_ = newSpeed;
-    for (auto &[id, package] : packages_) {
-        package.setSpeed(newSpeed);
-    }
+    LaneCommand command;
+    command.type = LaneCommand::SET_SPEED;
+    command.speed = newSpeed;
+    enqueue(command);
 }
 
 /**
  * @brief Limpa todos os pacotes armazenados.
  *
- * Esta função adquire um bloqueio no mutex `mtx_` para garantir que a operação
- * de limpeza seja realizada de forma segura em um ambiente multithread. Em seguida,
- * ela limpa o contêiner `packages_`, removendo todos os pacotes armazenados.
+ * Esta função agenda a remoção de todos os pacotes da esteira. Comandos inseridos depois
+ * dela (por exemplo, o pacote inicial de um novo jogo) são aplicados depois da limpeza.
  */
 void Threadmill::clearPackages() {
-    std::lock_guard<std::mutex> lock(mtx_);
-    packages_.clear();
+    LaneCommand command;
+    command.type = LaneCommand::CLEAR;
+    enqueue(command);
 }
 
 /**
- * @brief Ativa a Threadmill.
+ * @brief Coleta o primeiro pacote cujo centro está em `[leftX, rightX]`.
  *
- * Esta função ativa a Threadmill se ela ainda não estiver ativa. 
- * Utiliza um lock_guard para garantir que a operação de ativação 
- * seja thread-safe. Se a Threadmill não estiver ativa, ela é 
- * marcada como ativa e um semáforo é liberado.
+ * Sob `mtx_`, aplica os comandos pendentes, encontra o pacote por busca binária no PackageStore
+ * da esteira e o remove, publicando um novo snapshot e um LaneEvent::COLLECTED. Como a
+ * expiração também acontece sob `mtx_`, um pacote é coletado ou perdido, nunca ambos. A remoção
+ * não desloca os demais pacotes (veja PackageStore::erase), de modo que encontrar e remover o
+ * pacote custa O(log n), e a espera pelo mutex é limitada a um passo, que não percorre os
+ * pacotes. Se nenhum pacote estiver ao alcance, publica um snapshot apenas se algum comando foi
+ * aplicado, como applyCommands().
+ *
+ * @param leftX Limite esquerdo do alcance do jogador.
+ * @param rightX Limite direito do alcance do jogador.
+ * @return O pacote coletado, com sua posição no momento da coleta, ou std::nullopt se nenhum
+ *         estava ao alcance.
  */
-void Threadmill::activate() {
-    {
-        std::lock_guard<std::mutex> lock(mtx_);
-        if (!isActive_) {
-            isActive_ = true;
-            semaphore_.release();
-        }
+std::optional<Package> Threadmill::tryCollect(float leftX, float rightX) {
+    TRACE_SCOPE("Threadmill::tryCollect");
+    TRACE_LOCK(lock, mtx_, "Threadmill::mtx_ wait");
+    bool changed = drainCommands();
+
+    auto [first, last] = packages_.findByCenter(leftX, rightX);
+    first = packages_.nextPresent(first);
+    if (first >= last) {
+        if (changed)
+            publishSnapshot();
+        return std::nullopt;
     }
+
+    Package collected(packages_.idAt(first), packages_.xAt(first));
+    packages_.erase(collected.getId());
+    publishSnapshot();
+    emit(LaneEvent::COLLECTED, collected.getId(), 1, nowNanoseconds());
+    return collected;
 }
 
 /**
- * @brief Desativa a Threadmill.
+ * @brief Indica se há comandos inseridos que ainda não foram aplicados.
+ */
+bool Threadmill::hasPendingCommands() const {
+    return commands_.hasPending();
+}
+
+/**
+ * @brief Aplica os comandos pendentes sem avançar os pacotes.
  *
- * Esta função desativa a Threadmill, definindo a variável isActive_ como false.
- * A função utiliza um std::lock_guard para garantir que a operação seja thread-safe,
- * bloqueando o mutex mtx_ durante a execução.
+ * Usada para esteiras inativas, que não executam step() mas precisam refletir pacotes
+ * adicionados ou removidos. Publica um snapshot se algum comando foi aplicado.
  */
-void Threadmill::deactivate() {
-    std::lock_guard<std::mutex> lock(mtx_);
-    isActive_ = false;
+void Threadmill::applyCommands() {
+    TRACE_LOCK(lock, mtx_, "Threadmill::mtx_ wait");
+    if (drainCommands()) {
+        publishSnapshot();
+    }
 }
 
 /**
- * @brief Retorna o número de pacotes perdidos e reseta o contador.
+ * @brief Insere um comando na fila da esteira.
  *
- * Esta função obtém o número atual de pacotes perdidos, reseta o contador de pacotes perdidos para zero
- * e retorna o número de pacotes perdidos antes do reset.
+ * Não adquire `mtx_`. Se a fila estiver cheia, o produtor cede a vez até que a thread da
+ * esteira a esvazie, o que só ocorre se mais de COMMAND_CAPACITY comandos forem inseridos
+ * entre dois passos.
  *
- * @return int O número de pacotes perdidos antes do reset.
+ * @param command O comando.
  */
-int Threadmill::getAndResetLostPackages() {
-    std::lock_guard<std::mutex> lock(lostMutex_);
-    int temp = lostPackages_;
-    lostPackages_ = 0;
-    return temp;
+void Threadmill::enqueue(const LaneCommand &command) {
+    while (!commands_.tryPush(command)) {
+        std::this_thread::yield();
+    }
 }
 
 /**
- * @brief Desenha o estado atual do Threadmill na janela fornecida.
+ * @brief Aplica, em ordem, todos os comandos da fila.
  *
- * Esta função desenha a forma do Threadmill, os pacotes válidos e os textos de contagem de pacotes agrupados na janela fornecida.
+ * @note Deve ser chamada com `mtx_` adquirido.
  *
- * @param window Referência para a janela onde os elementos serão desenhados.
- * @param font Referência para a fonte usada para desenhar os textos de contagem.
+ * @return true se algum comando foi aplicado.
  */
-void Threadmill::draw(sf::RenderWindow &window, sf::Font &font) {
-    std::lock_guard<std::mutex> lock(mtx_);
-    window.draw(threadmillShape_);
-
-    std::vector<Package *> sortedPackages;
-    for (auto &[id, package] : packages_) {
-        if (package.isValid()) {
-            sortedPackages.push_back(&package);
-        }
+bool Threadmill::drainCommands() {
+    LaneCommand command;
+    bool applied = false;
+    int64_t now = 0;
+    while (commands_.tryPop(command)) {
+        if (!applied)
+            now = nowNanoseconds();
+        applyCommand(command, now);
+        applied = true;
+    }
+    if (applied) {
+        commands_.markConsumed();
     }
+    return applied;
+}
 
-    std::sort(sortedPackages.begin(), sortedPackages.end(),
-              [](Package *a, Package *b) { return a->getX() < b->getX(); });
-
-    std::vector<std::vector<Package *>> groups;
-    std::vector<bool> grouped(sortedPackages.size(), false);
-    for (size_t i = 0; i < sortedPackages.size(); ++i) {
-        if (grouped[i])
-            continue;
-        std::vector<Package *> group;
-        group.push_back(sortedPackages[i]);
-        grouped[i] = true;
-        float x1 = sortedPackages[i]->getX();
-        float x2 = x1 + PACKAGE_SIZE;
-        for (size_t j = i + 1; j < sortedPackages.size(); ++j) {
-            float centerX = sortedPackages[j]->getX() + PACKAGE_SIZE / 2.0f;
-            if (centerX >= x1 && centerX <= x2) {
-                group.push_back(sortedPackages[j]);
-                grouped[j] = true;
-            }
+/**
+ * @brief Aplica um comando ao PackageStore da esteira.
+ *
+ * Pacotes adicionados geram um LaneEvent::SPAWNED marcado com `now`.
+ *
+ * @note Deve ser chamada com `mtx_` adquirido.
+ */
+void Threadmill::applyCommand(const LaneCommand &command, int64_t now) {
+    switch (command.type) {
+    case LaneCommand::ADD:
+        packages_.push(command.id);
+        emit(LaneEvent::SPAWNED, command.id, 1, now);
+        break;
+    case LaneCommand::ADD_BATCH:
+        for (int i = 0; i < command.count; ++i) {
+            packages_.push(command.id + i);
         }
-        groups.push_back(group);
+        emit(LaneEvent::SPAWNED, command.id, command.count, now);
+        break;
+    case LaneCommand::REMOVE:
+        packages_.erase(command.id);
+        break;
+    case LaneCommand::SET_SPEED:
+        packages_.setSpeed(command.speed);
+        break;
+    case LaneCommand::CLEAR:
+        packages_.clear();
+        break;
     }
+}
 
-    for (auto &[id, package] : packages_) {
-        if (package.isValid()) {
-            package.draw(window);
-        }
+/**
+ * @brief Ativa a Threadmill.
+ *
+ * Esta função marca a Threadmill como ativa com uma escrita atômica, sem adquirir `mtx_`,
+ * de modo que ela passa a ser avançada pelo SimulationWorld. O instante da ativação é
+ * guardado antes de a esteira aparecer como ativa, para que o primeiro passo que a veja ativa
+ * também veja o instante e meça a latência até ele.
+ *
+ * @note activate() e deactivate() devem ser chamadas por uma única thread (a que controla o
+ *       jogador), como faz o SimulationWorld.
+ *
+ * @return true se a esteira estava inativa, false se já estava ativa.
+ */
+bool Threadmill::activate() {
+    if (isActive_.load(std::memory_order_acquire))
+        return false;
+    activatedAt_.store(std::chrono::steady_clock::now().time_since_epoch().count(),
+                       std::memory_order_relaxed);
+    isActive_.store(true, std::memory_order_release);
+    return true;
+}
+
+/**
+ * @brief Desativa a Threadmill.
+ *
+ * Esta função desativa a Threadmill com uma escrita atômica e em seguida adquire `mtx_`
+ * brevemente, apenas para esperar o fim de um passo que esteja em andamento. Ao retornar,
+ * nenhum pacote desta esteira se move até que ela seja ativada novamente, e o instante de uma
+ * ativação que nenhum passo chegou a medir é descartado.
+ */
+void Threadmill::deactivate() {
+    if (!isActive_.exchange(false, std::memory_order_acq_rel))
+        return;
+    TRACE_LOCK(lock, mtx_, "Threadmill::mtx_ wait");
+    activatedAt_.store(0, std::memory_order_relaxed);
+}
+
+bool Threadmill::isActive() const {
+    return isActive_.load(std::memory_order_acquire);
+}
+
+/**
+ * @brief Histograma do tempo entre activate() e o primeiro passo executado em seguida.
+ */
+const LatencyHistogram &Threadmill::getActivationLatency() const {
+    return activationLatency_;
+}
+
+/**
+ * @brief Número de eventos descartados porque o anel de eventos estava cheio.
+ */
+uint64_t Threadmill::getDroppedEvents() const {
+    return droppedEvents_.load(std::memory_order_relaxed);
+}
+
+/**
+ * @brief Publica um LaneEvent para a thread principal.
+ *
+ * Nunca bloqueia: se o anel estiver cheio, o evento é descartado e contado, e uma expiração é
+ * somada a `overflowExpired_`, que drainEvents() entrega antes dos demais eventos.
+ *
+ * @note Deve ser chamada com `mtx_` adquirido, o que serializa os produtores do SpscRing.
+ */
+void Threadmill::emit(LaneEvent::Type type, int packageId, int count, int64_t now) {
+    LaneEvent event;
+    event.type = type;
+    event.packageId = packageId;
+    event.count = count;
+    event.time = now;
+    if (events_.tryPush(event))
+        return;
+    droppedEvents_.fetch_add(1, std::memory_order_relaxed);
+    if (type == LaneEvent::EXPIRED)
+        overflowExpired_.fetch_add(count, std::memory_order_release);
+}
+
+/**
+ * @brief Obtém o snapshot mais recente dos pacotes da esteira.
+ *
+ * A leitura não adquire `mtx_` e não aloca memória: apenas troca o índice do buffer de leitura
+ * caso um snapshot mais novo tenha sido publicado. A referência retornada permanece válida até
+ * a próxima chamada desta função.
+ *
+ * @note Deve ser chamada por uma única thread leitora (a thread principal do jogo).
+ *
+ * @return const LaneSnapshot& Os pacotes da esteira na ordem de entrada.
+ */
+const LaneSnapshot &Threadmill::acquireSnapshot() {
+    return snapshots_.read();
+}
+
+
+/**
+ * @brief Avança a esteira em um passo de simulação.
+ *
+ * Aplica os comandos pendentes e atualiza todos os pacotes com o deltaTime informado sob o
+ * mutex da esteira. É chamado como tarefa do pool de threads do SimulationWorld a cada passo
+ * enquanto a esteira está ativa, ou diretamente no modo sem threads. Se a esteira estiver
+ * desativada, apenas aplica os comandos.
+ *
+ * @param deltaTime O tempo simulado do passo, em segundos.
+ */
+void Threadmill::step(float deltaTime) {
+    TRACE_SCOPE("Threadmill::step");
+    TRACE_LOCK(lock, mtx_, "Threadmill::mtx_ wait");
+    bool changed = drainCommands();
+    if (!isActive_.load(std::memory_order_acquire)) {
+        if (changed)
+            publishSnapshot();
+        return;
     }
 
-    for (auto &group : groups) {
-        if (group.size() > 1) {
-            Package *topPackage = nullptr;
-            float maxX = -1.0f;
-            for (auto *pkg : group) {
-                if (pkg->getX() > maxX) {
-                    maxX = pkg->getX();
-                    topPackage = pkg;
-                }
-            }
-            if (topPackage) {
-                sf::Text countText;
-                countText.setFont(font);
-                countText.setCharacterSize(SCORE_TEXT_SIZE);
-                countText.setFillColor(sf::Color::White);
-                countText.setString(std::to_string(group.size()));
-                float textX = topPackage->getX() + PACKAGE_SIZE / 2.0f;
-                float textY = topPackage->getBounds().top - 20.0f;
-                countText.setPosition(textX, textY);
-                window.draw(countText);
-            }
-        }
+    int64_t activatedAt = activatedAt_.exchange(0, std::memory_order_acq_rel);
+    if (activatedAt != 0) {
+        auto now = std::chrono::steady_clock::now().time_since_epoch();
+        activationLatency_.record(now - std::chrono::steady_clock::duration(activatedAt));
     }
+
+    updatePackages(deltaTime);
+    publishSnapshot();
 }
 
 /**
- * @brief Obtém um mapa de pacotes.
- * 
- * Esta função retorna um mapa contendo os pacotes armazenados no objeto Threadmill.
- * A função é thread-safe, utilizando um lock_guard para garantir que o acesso ao
- * mapa de pacotes seja protegido por um mutex.
- * 
- * @return std::map<int, Package> Um mapa onde a chave é um inteiro e o valor é um objeto Package.
+ * @brief Move os pacotes e remove os que ultrapassaram a esteira.
+ *
+ * Pacotes que ultrapassam a largura da tela são removidos e publicados como
+ * LaneEvent::EXPIRED, um por pacote. PackageStore::advance apenas avança o odômetro e retira os
+ * pacotes expirados do início; o relógio só é consultado se algum pacote expirou.
+ *
+ * @note Deve ser chamada com `mtx_` adquirido.
+ *
+ * @param deltaTime O tempo simulado do passo, em segundos.
  */
-std::map<int, Package> Threadmill::getPackages() {
-    std::lock_guard<std::mutex> lock(mtx_);
-    return packages_;
+void Threadmill::updatePackages(float deltaTime) {
+    int64_t now = 0;
+    packages_.advance(deltaTime, WIDTH, [this, &now](int id) {
+        if (now == 0)
+            now = nowNanoseconds();
+        emit(LaneEvent::EXPIRED, id, 1, now);
+    });
+}
+
+int Threadmill::getY() const {
+    return y_;
 }
 
 /**
- * @brief Método principal de execução da Threadmill.
+ * @brief Atualiza o buffer de escrita com o conteúdo atual da esteira e o publica.
  *
- * Este método é executado em um loop contínuo até que a sinalização de parada seja recebida.
- * Ele adquire um semáforo para controlar o acesso e utiliza mutexes para garantir a segurança
- * em operações concorrentes. O método processa pacotes, atualizando-os a cada iteração com
- * base em um deltaTime fixo, simulando aproximadamente 60 FPS. Pacotes que se tornam inválidos
- * ou ultrapassam uma largura definida são removidos e contabilizados como perdidos.
+ * O buffer guarda as sequências que tinha da última vez que foi escrito. Só as posições que
+ * entraram desde então são copiadas, as remoções registradas desde então são marcadas, e o
+ * início avança para o da esteira; o custo é proporcional ao que mudou, e não ao número de
+ * pacotes. A esteira inteira só é copiada quando o anel do PackageStore cresceu além do buffer
+ * (o que aloca memória, como o próprio crescimento) ou quando o buffer ficou mais de
+ * REMOVAL_LOG_CAPACITY remoções para trás, por exemplo se o leitor o reteve por muito tempo.
  *
- * @note O método utiliza um loop interno adicional para processar pacotes enquanto a Threadmill
- *       estiver ativa e não tiver recebido a sinalização de parada.
+ * @note Deve ser chamada com `mtx_` adquirido, o que serializa os escritores do TripleBuffer.
  */
-void Threadmill::run() {
-    while (true) {
-        semaphore_.acquire();
-        {
-            std::lock_guard<std::mutex> lock(mtx_);
-            if (stop_)
-                break;
-        }
+void Threadmill::publishSnapshot() {
+    LaneSnapshot &snapshot = snapshots_.writeBuffer();
+    snapshot.epoch = ++snapshotEpoch_;
+    snapshot.odometer = packages_.getOdometer();
+    snapshot.packageCount = packages_.presentCount();
 
-        while (true) {
-            {
-                std::lock_guard<std::mutex> lock(mtx_);
-                if (!isActive_ || stop_) {
-                    break;
-                }
-            }
-
-            float deltaTime = 0.016f; // Approx. 60 FPS
-            {
-                std::lock_guard<std::mutex> lock(mtx_);
-                std::vector<int> packagesToRemove;
-                for (auto &[id, package] : packages_) {
-                    if (package.isValid()) {
-                        package.update(deltaTime);
-                        if (package.getX() > WIDTH) {
-                            packagesToRemove.push_back(id);
-                            {
-                                std::lock_guard<std::mutex> lostLock(lostMutex_);
-                                lostPackages_++;
-                            }
-                        }
-                    }
-                }
-                for (int id : packagesToRemove) {
-                    packages_.erase(id);
-                }
-            }
-
-            std::this_thread::sleep_for(std::chrono::milliseconds(16));
+    uint64_t head = packages_.getHead();
+    uint64_t tail = packages_.getTail();
+    uint64_t removals = packages_.getRemovalCount();
+    uint64_t copyFrom = std::max(snapshot.tail, head);
+    if (snapshot.ids.size() < packages_.capacity() ||
+        removals - snapshot.removals > PackageStore::REMOVAL_LOG_CAPACITY) {
+        snapshot.ids.resize(std::max(snapshot.ids.size(), packages_.capacity()));
+        snapshot.entries.resize(snapshot.ids.size());
+        copyFrom = head;
+    } else {
+        std::size_t mask = snapshot.ids.size() - 1;
+        for (uint64_t removal = snapshot.removals; removal < removals; ++removal) {
+            uint64_t sequence = packages_.removedSequence(removal);
+            if (sequence >= head && sequence < copyFrom)
+                snapshot.ids[sequence & mask] = INVALID;
         }
+    }
 
-        {
-            std::lock_guard<std::mutex> lock(mtx_);
-            if (stop_)
-                break;
-        }
+    std::size_t mask = snapshot.ids.size() - 1;
+    for (uint64_t sequence = copyFrom; sequence < tail; ++sequence) {
+        std::size_t index = static_cast<std::size_t>(sequence - head);
+        snapshot.ids[sequence & mask] =
+            packages_.isRemoved(index) ? INVALID : packages_.idAt(index);
+        snapshot.entries[sequence & mask] = packages_.entryAt(index);
     }
+    snapshot.head = head;
+    snapshot.tail = tail;
+    snapshot.removals = removals;
+    snapshots_.publish();
 }
 
-bool Threadmill::loadTexture() {
-    return threadmillTexture_.loadFromFile(THREADMILL_TEXTURE_PATH);
+/**
+ * @brief Posição vertical comum a todos os pacotes desta esteira.
+ */
+float Threadmill::getPackageY() const {
+    return y_ + (THREADMILL_HEIGHT - PACKAGE_SIZE) / 2.0f;
 }
\ No newline at end of file
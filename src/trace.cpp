@@ -0,0 +1,159 @@
+#include <trace.h>
+
+#ifdef THREADMILL_TRACE
+
+#include <atomic>
+#include <cstdio>
+#include <memory>
+#include <vector>
+
+namespace trace {
+
+namespace {
+
+constexpr std::size_t EVENTS_PER_THREAD = 1 << 16;
+
+struct Event {
+    const char *name;
+    Category category;
+    int64_t startNs;
+    int64_t durationNs;
+};
+
+/**
+ * @brief Buffer circular de eventos de uma thread.
+ *
+ * Só a thread dona escreve; `written` é publicado com release para que a exportação, feita depois
+ * que as threads instrumentadas terminaram, veja todos os eventos.
+ */
+struct ThreadBuffer {
+    int tid = 0;
+    const char *name = nullptr;
+    std::vector<Event> events = std::vector<Event>(EVENTS_PER_THREAD);
+    std::atomic<uint64_t> written{0};
+};
+
+const std::chrono::steady_clock::time_point traceEpoch = std::chrono::steady_clock::now();
+
+std::mutex registryMutex;
+std::vector<std::unique_ptr<ThreadBuffer>> registry;
+
+/**
+ * @brief Buffer da thread atual, criado e registrado no primeiro uso.
+ *
+ * Os buffers pertencem ao registro, e não à thread, para que sobrevivam a ela e possam ser
+ * exportados depois que o pool e a thread das esteiras terminaram.
+ */
+ThreadBuffer &localBuffer() {
+    thread_local ThreadBuffer *buffer = [] {
+        std::lock_guard<std::mutex> lock(registryMutex);
+        registry.push_back(std::make_unique<ThreadBuffer>());
+        registry.back()->tid = static_cast<int>(registry.size());
+        return registry.back().get();
+    }();
+    return *buffer;
+}
+
+const char *categoryName(Category category) {
+    return category == Category::LOCK_WAIT ? "lock_wait" : "scope";
+}
+
+/**
+ * @brief Percorre os eventos de um buffer do mais antigo ao mais novo.
+ */
+template <typename Fn> void forEachEvent(const ThreadBuffer &buffer, Fn &&fn) {
+    uint64_t written = buffer.written.load(std::memory_order_acquire);
+    uint64_t first = written > EVENTS_PER_THREAD ? written - EVENTS_PER_THREAD : 0;
+    for (uint64_t i = first; i < written; ++i) {
+        fn(buffer.events[i % EVENTS_PER_THREAD]);
+    }
+}
+
+} // namespace
+
+int64_t nowNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now() - traceEpoch)
+        .count();
+}
+
+/**
+ * @brief Grava um evento no buffer da thread atual, sobrescrevendo o mais antigo se estiver cheio.
+ */
+void record(const char *name, Category category, int64_t startNs, int64_t durationNs) {
+    ThreadBuffer &buffer = localBuffer();
+    uint64_t index = buffer.written.load(std::memory_order_relaxed);
+    buffer.events[index % EVENTS_PER_THREAD] = {name, category, startNs, durationNs};
+    buffer.written.store(index + 1, std::memory_order_release);
+}
+
+void setThreadName(const char *name) {
+    localBuffer().name = name;
+}
+
+/**
+ * @brief Exporta todos os eventos no formato JSON `trace_event` do Chrome.
+ *
+ * @note Deve ser chamada depois que as threads instrumentadas terminaram.
+ *
+ * @param path Caminho do arquivo a ser criado.
+ * @return false se o arquivo não pôde ser escrito.
+ */
+bool dumpChromeJson(const std::string &path) {
+    std::FILE *file = std::fopen(path.c_str(), "w");
+    if (!file)
+        return false;
+
+    std::lock_guard<std::mutex> lock(registryMutex);
+    std::fputs("{\"traceEvents\":[\n", file);
+    bool first = true;
+    for (const auto &buffer : registry) {
+        if (buffer->name) {
+            std::fprintf(file,
+                         "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%d,"
+                         "\"args\":{\"name\":\"%s\"}}",
+                         first ? "" : ",\n", buffer->tid, buffer->name);
+            first = false;
+        }
+        forEachEvent(*buffer, [&](const Event &event) {
+            std::fprintf(file,
+                         "%s{\"name\":\"%s\",\"cat\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":%d,"
+                         "\"ts\":%.3f,\"dur\":%.3f}",
+                         first ? "" : ",\n", event.name, categoryName(event.category), buffer->tid,
+                         event.startNs / 1000.0, event.durationNs / 1000.0);
+            first = false;
+        });
+    }
+    std::fputs("\n]}\n", file);
+    return std::fclose(file) == 0;
+}
+
+/**
+ * @brief Exporta todos os eventos em CSV: thread, categoria, nome, início e duração em ns.
+ *
+ * @note Deve ser chamada depois que as threads instrumentadas terminaram.
+ *
+ * @param path Caminho do arquivo a ser criado.
+ * @return false se o arquivo não pôde ser escrito.
+ */
+bool dumpCsv(const std::string &path) {
+    std::FILE *file = std::fopen(path.c_str(), "w");
+    if (!file)
+        return false;
+
+    std::lock_guard<std::mutex> lock(registryMutex);
+    std::fputs("tid,thread,category,name,start_ns,duration_ns\n", file);
+    for (const auto &buffer : registry) {
+        forEachEvent(*buffer, [&](const Event &event) {
+            std::fprintf(file, "%d,%s,%s,%s,%lld,%lld\n", buffer->tid,
+                         buffer->name ? buffer->name : "", categoryName(event.category), event.name,
+                         static_cast<long long>(event.startNs),
+                         static_cast<long long>(event.durationNs));
+        });
+    }
+    return std::fclose(file) == 0;
+}
+
+} // namespace trace
+
+#endif // THREADMILL_TRACE
@@ -0,0 +1,167 @@
+#include <trace.h>
+#include <work_stealing_pool.h>
+
+namespace {
+/// Pool e índice do trabalhador que executa a thread atual (nullptr fora de um pool).
+thread_local const WorkStealingPool *currentPool = nullptr;
+thread_local unsigned currentWorker = 0;
+} // namespace
+
+/**
+ * @brief Construtor da classe WorkStealingPool.
+ *
+ * Cria `threadCount` trabalhadores, cada um com sua própria fila de tarefas.
+ *
+ * @param threadCount Número de threads; por padrão, o número de núcleos da máquina (mínimo 1).
+ */
+WorkStealingPool::WorkStealingPool(unsigned threadCount)
+    : nextQueue_(0), queued_(0), unfinished_(0), stop_(false) {
+    if (threadCount == 0)
+        threadCount = 1;
+    for (unsigned i = 0; i < threadCount; ++i) {
+        workers_.push_back(std::make_unique<Worker>());
+    }
+    for (unsigned i = 0; i < threadCount; ++i) {
+        threads_.emplace_back(&WorkStealingPool::workerLoop, this, i);
+    }
+}
+
+/**
+ * @brief Destrutor da classe WorkStealingPool.
+ *
+ * Aguarda as tarefas pendentes, sinaliza a parada e junta todas as threads.
+ */
+WorkStealingPool::~WorkStealingPool() {
+    wait();
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex_);
+        stop_ = true;
+    }
+    wakeCv_.notify_all();
+    for (std::thread &thread : threads_) {
+        thread.join();
+    }
+}
+
+/**
+ * @brief Submete uma tarefa ao pool.
+ *
+ * Se chamada por um trabalhador deste pool, a tarefa vai para a fila dele; caso contrário,
+ * é distribuída em rodízio entre as filas. Um trabalhador adormecido é acordado.
+ *
+ * @param task A tarefa a executar.
+ */
+void WorkStealingPool::submit(std::function<void()> task) {
+    unsigned index = currentPool == this
+                         ? currentWorker
+                         : nextQueue_.fetch_add(1, std::memory_order_relaxed) % workers_.size();
+    unfinished_.fetch_add(1, std::memory_order_relaxed);
+    {
+        std::lock_guard<std::mutex> lock(workers_[index]->mtx);
+        workers_[index]->tasks.push_back(std::move(task));
+    }
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex_);
+        queued_.fetch_add(1, std::memory_order_relaxed);
+    }
+    wakeCv_.notify_one();
+}
+
+/**
+ * @brief Bloqueia até que todas as tarefas submetidas tenham terminado.
+ */
+void WorkStealingPool::wait() {
+    int remaining = unfinished_.load(std::memory_order_acquire);
+    while (remaining != 0) {
+        unfinished_.wait(remaining, std::memory_order_acquire);
+        remaining = unfinished_.load(std::memory_order_acquire);
+    }
+}
+
+unsigned WorkStealingPool::size() const {
+    return static_cast<unsigned>(workers_.size());
+}
+
+/**
+ * @brief Laço de cada trabalhador: executa a própria fila, rouba das outras ou dorme.
+ *
+ * @param index Índice do trabalhador.
+ */
+void WorkStealingPool::workerLoop(unsigned index) {
+    currentPool = this;
+    currentWorker = index;
+    TRACE_THREAD_NAME("worker");
+
+    std::function<void()> task;
+    while (true) {
+        if (popLocal(index, task) || steal(index, task)) {
+            queued_.fetch_sub(1, std::memory_order_relaxed);
+            task();
+            task = nullptr;
+            finishTask();
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(sleepMutex_);
+        wakeCv_.wait(lock, [this] { return stop_ || queued_.load(std::memory_order_relaxed) > 0; });
+        if (stop_ && queued_.load(std::memory_order_relaxed) == 0)
+            return;
+    }
+}
+
+/**
+ * @brief Retira uma tarefa do fim da fila do próprio trabalhador.
+ */
+bool WorkStealingPool::popLocal(unsigned index, std::function<void()> &task) {
+    Worker &worker = *workers_[index];
+    std::lock_guard<std::mutex> lock(worker.mtx);
+    if (worker.empty())
+        return false;
+    task = std::move(worker.tasks.back());
+    worker.tasks.pop_back();
+    releaseConsumed(worker);
+    return true;
+}
+
+/**
+ * @brief Rouba uma tarefa do início da fila de outro trabalhador.
+ */
+bool WorkStealingPool::steal(unsigned thief, std::function<void()> &task) {
+    for (unsigned offset = 1; offset < workers_.size(); ++offset) {
+        Worker &victim = *workers_[(thief + offset) % workers_.size()];
+        std::lock_guard<std::mutex> lock(victim.mtx);
+        if (victim.empty())
+            continue;
+        task = std::move(victim.tasks[victim.head++]);
+        releaseConsumed(victim);
+        return true;
+    }
+    return false;
+}
+
+/**
+ * @brief Descarta as posições já roubadas do início da fila, sem liberar a capacidade do vetor.
+ *
+ * Quando a fila esvazia ela é simplesmente limpa; se ladrões consumiram mais da metade dela, as
+ * tarefas restantes são movidas para o início.
+ *
+ * @note Deve ser chamada com o mutex do trabalhador adquirido.
+ */
+void WorkStealingPool::releaseConsumed(Worker &worker) {
+    if (worker.empty()) {
+        worker.tasks.clear();
+        worker.head = 0;
+    } else if (worker.head * 2 > worker.tasks.size()) {
+        worker.tasks.erase(worker.tasks.begin(), worker.tasks.begin() + worker.head);
+        worker.head = 0;
+    }
+}
+
+/**
+ * @brief Contabiliza o fim de uma tarefa e acorda quem espera em wait().
+ */
+void WorkStealingPool::finishTask() {
+    if (unfinished_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        unfinished_.notify_all();
+    }
+}
@@ -0,0 +1,30 @@
+#!/bin/sh
+# Gera um arquivo C++ com o conteúdo dos arquivos informados em arrays de bytes (EMBEDDED_ASSETS).
+# Uso: sh tools/embed_assets.sh <saida.cpp> <arquivo>...
+out=$1
+shift
+mkdir -p "$(dirname "$out")"
+{
+    echo '// Gerado por tools/embed_assets.sh a partir de assets/; não edite.'
+    echo '#include <embedded_assets.h>'
+    echo
+    echo 'namespace {'
+    i=0
+    for file in "$@"; do
+        echo "const unsigned char ASSET_$i[] = {"
+        od -An -v -tu1 "$file" | awk '{ line = "   "; for (i = 1; i <= NF; ++i) line = line " " $i ","; print line }'
+        echo '};'
+        i=$((i + 1))
+    done
+    echo '} // namespace'
+    echo
+    echo 'const EmbeddedAsset EMBEDDED_ASSETS[] = {'
+    i=0
+    for file in "$@"; do
+        echo "    {\"$file\", ASSET_$i, sizeof(ASSET_$i)},"
+        i=$((i + 1))
+    done
+    echo '};'
+    echo
+    echo 'const std::size_t EMBEDDED_ASSET_COUNT = sizeof(EMBEDDED_ASSETS) / sizeof(EMBEDDED_ASSETS[0]);'
+} > "$out.tmp" && mv "$out.tmp" "$out"